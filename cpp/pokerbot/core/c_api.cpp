@@ -2,11 +2,55 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
+#include "cfr.h"
+#include "hand_evaluator.h"
+#include "hand_history.h"
+#include "inference_scheduler.h"
+#include "ismcts.h"
+#include "opponent_range.h"
+#include "replay.h"
+#include "shared_training.h"
+#include "state_pool.h"
+#include "thread_pool.h"
+
+using pokerbot::core::ActionLogEntry;
 using pokerbot::core::ActionType;
+using pokerbot::core::BarrierResult;
+using pokerbot::core::CfrOptions;
+using pokerbot::core::CfrStats;
+using pokerbot::core::CfrTrainer;
+using pokerbot::core::CfrVariant;
+using pokerbot::core::GameSnapshot;
 using pokerbot::core::GameState;
+using pokerbot::core::GameStatePool;
+using pokerbot::core::HandHistoryCursor;
+using pokerbot::core::HandHistoryReader;
+using pokerbot::core::HandHistoryWriter;
+using pokerbot::core::HandHistoryWriterOptions;
+using pokerbot::core::HandRecord;
+using pokerbot::core::InferenceBatch;
+using pokerbot::core::InferenceScheduler;
+using pokerbot::core::InferenceSchedulerOptions;
+using pokerbot::core::InferenceSchedulerStats;
+using pokerbot::core::IsmctsOptions;
+using pokerbot::core::IsmctsResult;
+using pokerbot::core::NumaPolicy;
+using pokerbot::core::OpponentRange;
+using pokerbot::core::RegretTable;
+using pokerbot::core::ReplayDecisionVisitor;
+using pokerbot::core::ReplayOptions;
+using pokerbot::core::ReplayResult;
+using pokerbot::core::ReplayResultSink;
+using pokerbot::core::ReplaySummary;
+using pokerbot::core::SharedTrainingSegment;
+using pokerbot::core::ThreadPool;
+using pokerbot::core::ThreadPoolOptions;
 using pokerbot::core::kDeckSize;
 using pokerbot::core::kNumPlayers;
 
@@ -14,6 +58,143 @@ struct PokerbotGameState {
   GameState impl;
 };
 
+struct PokerbotStatePool {
+  explicit PokerbotStatePool(size_t capacity) : impl(capacity) {}
+
+  GameStatePool impl;
+};
+
+struct PokerbotCfrTrainer {
+  explicit PokerbotCfrTrainer(const CfrOptions& options,
+                              RegretTable* table = nullptr)
+      : impl(pokerbot::core::GameConfig(), options, table) {}
+
+  CfrTrainer impl;
+};
+
+struct PokerbotRange {
+  OpponentRange impl;
+};
+
+struct PokerbotSharedSegment {
+  std::unique_ptr<SharedTrainingSegment> impl;
+};
+
+struct PokerbotHandHistoryWriter {
+  std::unique_ptr<HandHistoryWriter> impl;
+};
+
+struct PokerbotHandHistoryReader {
+  std::unique_ptr<HandHistoryReader> impl;
+};
+
+struct PokerbotInferenceBatch {
+  const InferenceBatch& impl;
+};
+
+struct PokerbotHistoryCursor {
+  HandHistoryCursor impl;
+  HandRecord record;
+};
+
+namespace {
+
+// Copies a decoded record into the flat output buffers of the history API
+// (each optional). Returns the record's action count.
+int CopyRecord(const HandRecord& record, uint64_t* hand_id_out,
+               uint8_t* deck_out, int64_t* payoffs_out, int* actions_out,
+               int max_actions) {
+  if (hand_id_out) {
+    *hand_id_out = record.hand_id;
+  }
+  if (deck_out) {
+    std::copy(record.deck.begin(), record.deck.end(), deck_out);
+  }
+  if (payoffs_out) {
+    for (int i = 0; i < kNumPlayers; ++i) {
+      payoffs_out[i] = record.payoffs[i];
+    }
+  }
+  const int count = static_cast<int>(record.actions.size());
+  if (actions_out) {
+    const int copied = std::min(count, max_actions);
+    for (int i = 0; i < copied; ++i) {
+      actions_out[i] = static_cast<int>(record.actions[i].action);
+    }
+  }
+  return count;
+}
+
+void CopyReplaySummary(const ReplaySummary& summary, int64_t* out) {
+  if (!out) {
+    return;
+  }
+  out[0] = static_cast<int64_t>(summary.hands);
+  out[1] = static_cast<int64_t>(summary.ok);
+  out[2] = static_cast<int64_t>(summary.illegal_action);
+  out[3] = static_cast<int64_t>(summary.payoff_mismatch);
+  out[4] = static_cast<int64_t>(summary.incomplete);
+}
+
+// Hands a record to a PokerbotHistoryRecordFn.
+int CallRecordFn(PokerbotHistoryRecordFn fn, const HandRecord& record,
+                 std::vector<int>* actions, void* user_data) {
+  actions->resize(record.actions.size());
+  const int count = CopyRecord(record, nullptr, nullptr, nullptr,
+                               actions->data(),
+                               static_cast<int>(actions->size()));
+  return fn(record.hand_id, record.deck.data(), record.payoffs.data(),
+            actions->data(), count, user_data);
+}
+
+// Copies `count` 52-card decks, rejecting any that is not a permutation.
+bool ReadDecks(const uint8_t* decks, int count,
+               std::vector<std::array<uint8_t, kDeckSize>>* out) {
+  if (count > 0 && !decks) {
+    return false;
+  }
+  out->resize(static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    std::array<uint8_t, kDeckSize>& deck = (*out)[i];
+    std::memcpy(deck.data(), decks + static_cast<size_t>(i) * kDeckSize,
+                kDeckSize);
+    uint64_t seen = 0;
+    for (uint8_t card : deck) {
+      if (card >= kDeckSize || (seen & (uint64_t{1} << card)) != 0) {
+        return false;
+      }
+      seen |= uint64_t{1} << card;
+    }
+  }
+  return true;
+}
+
+bool ConvertCfrOptions(const PokerbotCfrOptions* options, CfrOptions* out) {
+  PokerbotCfrOptions raw;
+  pokerbot_cfr_default_options(&raw);
+  if (options) {
+    raw = *options;
+  }
+  if (raw.variant < 0 || raw.variant > 3 || raw.table_capacity <= 0) {
+    return false;
+  }
+  out->variant = static_cast<CfrVariant>(raw.variant);
+  out->alternating_updates = raw.alternating_updates != 0;
+  out->regret_pruning = raw.regret_pruning != 0;
+  out->alpha = raw.alpha;
+  out->beta = raw.beta;
+  out->gamma = raw.gamma;
+  out->prune_threshold = raw.prune_threshold;
+  out->discount_interval = raw.discount_interval;
+  out->prune_warmup_iterations = raw.prune_warmup_iterations;
+  out->prune_recheck_interval = raw.prune_recheck_interval;
+  out->table_capacity = static_cast<size_t>(raw.table_capacity);
+  out->seed = raw.seed;
+  return true;
+}
+
+}  // namespace
+
 extern "C" {
 
 PokerbotGameState* pokerbot_state_create() {
@@ -35,15 +216,20 @@ void pokerbot_state_reset(PokerbotGameState* state, uint64_t seed) {
   state->impl.Reset(seed);
 }
 
-void pokerbot_state_reset_with_deck(PokerbotGameState* state,
-                                    const uint8_t* deck,
-                                    int deck_size) {
+int pokerbot_state_reset_with_deck(PokerbotGameState* state,
+                                   const uint8_t* deck,
+                                   int deck_size) {
   if (!state || !deck || deck_size < kDeckSize) {
-    return;
+    return 0;
   }
   std::array<uint8_t, kDeckSize> local_deck{};
   std::memcpy(local_deck.data(), deck, kDeckSize);
-  state->impl.ResetWithDeck(local_deck);
+  try {
+    state->impl.ResetWithDeck(local_deck);
+  } catch (...) {
+    return 0;
+  }
+  return 1;
 }
 
 int pokerbot_state_current_player(const PokerbotGameState* state) {
@@ -166,4 +352,1047 @@ void pokerbot_state_payoffs(const PokerbotGameState* state, int64_t* out) {
   }
 }
 
+uint64_t pokerbot_state_hand_strength(const PokerbotGameState* state,
+                                      int player) {
+  if (!state) {
+    return 0;
+  }
+  try {
+    return state->impl.HandStrength(player);
+  } catch (...) {
+    return 0;
+  }
+}
+
+uint64_t pokerbot_evaluate_best_hand(const uint8_t* cards, int count) {
+  if (!cards || count < 5 || count > 7) {
+    return 0;
+  }
+  try {
+    return pokerbot::core::EvaluateBestHand(
+        std::vector<uint8_t>(cards, cards + count));
+  } catch (...) {
+    return 0;
+  }
+}
+
+uint64_t pokerbot_evaluate_with_board(const uint8_t* hole_cards,
+                                      const uint8_t* board, int board_count) {
+  if (!hole_cards || !board || board_count < 3 || board_count > 5) {
+    return 0;
+  }
+  try {
+    pokerbot::core::BoardEvaluator evaluator;
+    for (int i = 0; i < board_count; ++i) {
+      evaluator.AddCard(board[i]);
+    }
+    return evaluator.Evaluate({hole_cards[0], hole_cards[1]});
+  } catch (...) {
+    return 0;
+  }
+}
+
+int pokerbot_snapshot_size() {
+  return static_cast<int>(sizeof(GameSnapshot));
+}
+
+int pokerbot_state_snapshot_batch(const PokerbotGameState* const* states,
+                                  int count, uint8_t* out) {
+  if (!states || !out) {
+    return 0;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (!states[i]) {
+      return i;
+    }
+    try {
+      const GameSnapshot snapshot = states[i]->impl.Snapshot();
+      std::memcpy(out + i * sizeof(GameSnapshot), &snapshot,
+                  sizeof(GameSnapshot));
+    } catch (...) {
+      return i;
+    }
+  }
+  return count;
+}
+
+int pokerbot_state_restore_batch(PokerbotGameState* const* states, int count,
+                                 const uint8_t* in) {
+  if (!states || !in) {
+    return 0;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (!states[i]) {
+      return i;
+    }
+    GameSnapshot snapshot;
+    std::memcpy(&snapshot, in + i * sizeof(GameSnapshot), sizeof(GameSnapshot));
+    try {
+      states[i]->impl.Restore(snapshot);
+    } catch (...) {
+      return i;
+    }
+  }
+  return count;
+}
+
+PokerbotStatePool* pokerbot_pool_create(int capacity) {
+  if (capacity <= 0) {
+    return nullptr;
+  }
+  try {
+    return new PokerbotStatePool(static_cast<size_t>(capacity));
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_pool_destroy(PokerbotStatePool* pool) {
+  delete pool;
+}
+
+int pokerbot_pool_capacity(const PokerbotStatePool* pool) {
+  return pool ? static_cast<int>(pool->impl.capacity()) : 0;
+}
+
+int pokerbot_pool_in_use(const PokerbotStatePool* pool) {
+  return pool ? static_cast<int>(pool->impl.in_use()) : 0;
+}
+
+int pokerbot_pool_acquire(PokerbotStatePool* pool, int count,
+                          uint64_t* handles_out) {
+  if (!pool || count < 0 || (count > 0 && !handles_out)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  return pool->impl.Acquire(static_cast<size_t>(count), handles_out)
+             ? POKERBOT_OK
+             : POKERBOT_ERR_POOL_EXHAUSTED;
+}
+
+int pokerbot_pool_release(PokerbotStatePool* pool, const uint64_t* handles,
+                          int count) {
+  if (!pool || count < 0 || (count > 0 && !handles)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const size_t released =
+      pool->impl.Release(handles, static_cast<size_t>(count));
+  return released == static_cast<size_t>(count) ? POKERBOT_OK
+                                                : POKERBOT_ERR_INVALID_HANDLE;
+}
+
+int pokerbot_pool_reset(PokerbotStatePool* pool, const uint64_t* handles,
+                        const uint64_t* seeds, int count) {
+  if (!pool || count < 0 || (count > 0 && (!handles || !seeds))) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (!pool->impl.Get(handles[i])) {
+      return POKERBOT_ERR_INVALID_HANDLE;
+    }
+  }
+  for (int i = 0; i < count; ++i) {
+    pool->impl.Get(handles[i])->Reset(seeds[i]);
+  }
+  return POKERBOT_OK;
+}
+
+int pokerbot_pool_reset_with_decks(PokerbotStatePool* pool,
+                                   const uint64_t* handles,
+                                   const uint8_t* decks, int count) {
+  if (!pool || count < 0 || (count > 0 && (!handles || !decks))) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (!pool->impl.Get(handles[i])) {
+      return POKERBOT_ERR_INVALID_HANDLE;
+    }
+  }
+  std::vector<std::array<uint8_t, kDeckSize>> local_decks;
+  if (!ReadDecks(decks, count, &local_decks)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  for (int i = 0; i < count; ++i) {
+    pool->impl.Get(handles[i])->ResetWithDeck(local_decks[i]);
+  }
+  return POKERBOT_OK;
+}
+
+int pokerbot_pool_apply(PokerbotStatePool* pool, const uint64_t* handles,
+                        const int* actions, int count, int* statuses_out) {
+  if (!pool || count < 0 || (count > 0 && (!handles || !actions))) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  int first_error = POKERBOT_OK;
+  for (int i = 0; i < count; ++i) {
+    GameState* state = pool->impl.Get(handles[i]);
+    int status = POKERBOT_OK;
+    if (!state) {
+      status = POKERBOT_ERR_INVALID_HANDLE;
+    } else {
+      try {
+        if (!state->ApplyAction(static_cast<ActionType>(actions[i]))) {
+          status = POKERBOT_ERR_ILLEGAL_ACTION;
+        }
+      } catch (...) {
+        status = POKERBOT_ERR_INTERNAL;
+      }
+    }
+    if (statuses_out) {
+      statuses_out[i] = status;
+    }
+    if (first_error == POKERBOT_OK) {
+      first_error = status;
+    }
+  }
+  return first_error;
+}
+
+int pokerbot_pool_query(const PokerbotStatePool* pool,
+                        const uint64_t* handles, int count,
+                        PokerbotStateInfo* out) {
+  if (!pool || count < 0 || (count > 0 && (!handles || !out))) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  int first_error = POKERBOT_OK;
+  for (int i = 0; i < count; ++i) {
+    const GameState* state = pool->impl.Get(handles[i]);
+    PokerbotStateInfo& info = out[i];
+    info = PokerbotStateInfo{};
+    if (!state) {
+      info.current_player = -1;
+      info.winner = -1;
+      if (first_error == POKERBOT_OK) {
+        first_error = POKERBOT_ERR_INVALID_HANDLE;
+      }
+      continue;
+    }
+    const int player = state->current_player();
+    info.current_player = player;
+    info.betting_round = state->betting_round();
+    info.is_terminal = state->is_terminal() ? 1 : 0;
+    info.terminal_reason = static_cast<int32_t>(state->terminal_reason());
+    info.winner = state->winner();
+    info.board_count = state->board_card_count();
+    info.legal_action_mask = state->LegalActionMask();
+    info.pot = state->pot();
+    info.to_call = player >= 0 ? state->ToCall(player) : 0;
+    const auto payoffs = state->payoffs();
+    info.payoffs[0] = payoffs[0];
+    info.payoffs[1] = payoffs[1];
+  }
+  return first_error;
+}
+
+void pokerbot_cfr_default_options(PokerbotCfrOptions* out) {
+  if (!out) {
+    return;
+  }
+  const CfrOptions defaults;
+  *out = PokerbotCfrOptions{};
+  out->variant = static_cast<int32_t>(defaults.variant);
+  out->alternating_updates = defaults.alternating_updates ? 1 : 0;
+  out->regret_pruning = defaults.regret_pruning ? 1 : 0;
+  out->alpha = defaults.alpha;
+  out->beta = defaults.beta;
+  out->gamma = defaults.gamma;
+  out->prune_threshold = defaults.prune_threshold;
+  out->discount_interval = defaults.discount_interval;
+  out->prune_warmup_iterations = defaults.prune_warmup_iterations;
+  out->prune_recheck_interval = defaults.prune_recheck_interval;
+  out->table_capacity = static_cast<int64_t>(defaults.table_capacity);
+  out->seed = defaults.seed;
+}
+
+PokerbotCfrTrainer* pokerbot_cfr_create(const PokerbotCfrOptions* options) {
+  CfrOptions converted;
+  if (!ConvertCfrOptions(options, &converted)) {
+    return nullptr;
+  }
+  try {
+    return new PokerbotCfrTrainer(converted);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_cfr_destroy(PokerbotCfrTrainer* trainer) {
+  delete trainer;
+}
+
+PokerbotCfrTrainer* pokerbot_cfr_create_shared(
+    const PokerbotCfrOptions* options, PokerbotSharedSegment* segment) {
+  CfrOptions converted;
+  if (!segment || !ConvertCfrOptions(options, &converted)) {
+    return nullptr;
+  }
+  converted.defer_discount = true;
+  try {
+    return new PokerbotCfrTrainer(converted, &segment->impl->table());
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+int pokerbot_cfr_run(PokerbotCfrTrainer* trainer, int64_t iterations) {
+  if (!trainer || iterations < 0) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    trainer->impl.RunIterations(iterations);
+    return POKERBOT_OK;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_cfr_stats(const PokerbotCfrTrainer* trainer, int64_t* out) {
+  if (!trainer || !out) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const CfrStats stats = trainer->impl.stats();
+  out[0] = stats.iterations;
+  out[1] = static_cast<int64_t>(stats.infosets);
+  out[2] = stats.nodes_visited;
+  out[3] = stats.actions_pruned;
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_run_shared_round(PokerbotCfrTrainer* trainer,
+                                  PokerbotSharedSegment* segment,
+                                  int64_t iterations, double timeout_ms) {
+  if (!trainer || !segment || iterations < 0) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    switch (pokerbot::core::RunSharedCfrRound(trainer->impl, *segment->impl,
+                                              iterations, timeout_ms)) {
+      case BarrierResult::kReleased:
+        return POKERBOT_OK;
+      case BarrierResult::kStopped:
+        return POKERBOT_STOPPED;
+      case BarrierResult::kTimeout:
+        return POKERBOT_ERR_TIMEOUT;
+    }
+    return POKERBOT_ERR_INTERNAL;
+  } catch (const std::invalid_argument&) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_cfr_average_strategy(const PokerbotCfrTrainer* trainer,
+                                  const PokerbotGameState* state,
+                                  double* out) {
+  if (!trainer || !state || !out) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  std::fill(out, out + pokerbot::core::kNumActionTypes, 0.0);
+  if (state->impl.is_terminal()) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const auto actions = state->impl.LegalActions();
+  const auto strategy = trainer->impl.AverageStrategy(state->impl);
+  for (size_t i = 0; i < actions.size(); ++i) {
+    out[static_cast<int>(actions[i])] = strategy[i];
+  }
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_infoset(const PokerbotCfrTrainer* trainer,
+                         const PokerbotGameState* state, double* regrets_out,
+                         double* strategy_sums_out) {
+  if (!trainer || !state) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  for (double* out : {regrets_out, strategy_sums_out}) {
+    if (out) {
+      std::fill(out, out + pokerbot::core::kNumActionTypes, 0.0);
+    }
+  }
+  if (state->impl.is_terminal()) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const RegretTable& table = trainer->impl.table();
+  const size_t slot = table.Find(trainer->impl.InfoSetKey(state->impl));
+  if (slot == table.capacity()) {
+    return POKERBOT_OK;
+  }
+  double regrets[pokerbot::core::kMaxInfoSetActions];
+  table.LoadRegrets(slot, regrets);
+  const auto actions = state->impl.LegalActions();
+  for (size_t i = 0; i < actions.size(); ++i) {
+    const int code = static_cast<int>(actions[i]);
+    if (regrets_out) {
+      regrets_out[code] = regrets[i];
+    }
+    if (strategy_sums_out) {
+      strategy_sums_out[code] = table.strategy_sum(slot)[i];
+    }
+  }
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_apply_discounts(PokerbotCfrTrainer* trainer,
+                                 int64_t from_iteration, int64_t to_iteration) {
+  if (!trainer || from_iteration < 0 || to_iteration < from_iteration) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  trainer->impl.ApplyDiscountsBetween(from_iteration, to_iteration);
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_set_deals(PokerbotCfrTrainer* trainer, const uint8_t* decks,
+                           int count) {
+  std::vector<std::array<uint8_t, kDeckSize>> deals;
+  if (!trainer || count < 0 || !ReadDecks(decks, count, &deals)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  trainer->impl.SetDeals(std::move(deals));
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_exploitability(const PokerbotCfrTrainer* trainer,
+                                const uint8_t* decks, int count,
+                                double* out) {
+  std::vector<std::array<uint8_t, kDeckSize>> deals;
+  if (!trainer || !out || count <= 0 || !ReadDecks(decks, count, &deals)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    *out = trainer->impl.Exploitability(deals);
+    return POKERBOT_OK;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+PokerbotSharedSegment* pokerbot_shared_create(const char* name,
+                                              int64_t capacity,
+                                              int num_workers) {
+  if (!name || capacity <= 0 || num_workers <= 0) {
+    return nullptr;
+  }
+  try {
+    return new PokerbotSharedSegment{SharedTrainingSegment::Create(
+        name, static_cast<size_t>(capacity), num_workers)};
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+PokerbotSharedSegment* pokerbot_shared_attach(const char* name) {
+  if (!name) {
+    return nullptr;
+  }
+  try {
+    return new PokerbotSharedSegment{SharedTrainingSegment::Attach(name)};
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_shared_close(PokerbotSharedSegment* segment) {
+  delete segment;
+}
+
+int64_t pokerbot_shared_iteration(const PokerbotSharedSegment* segment) {
+  return segment ? segment->impl->iteration() : -1;
+}
+
+int pokerbot_shared_request_stop(PokerbotSharedSegment* segment) {
+  if (!segment) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  segment->impl->RequestStop();
+  return POKERBOT_OK;
+}
+
+int64_t pokerbot_shared_request_checkpoint(PokerbotSharedSegment* segment,
+                                           const char* path) {
+  if (!segment || !path) {
+    return -1;
+  }
+  try {
+    return segment->impl->RequestCheckpoint(path);
+  } catch (...) {
+    return -1;
+  }
+}
+
+int pokerbot_shared_wait_checkpoint(const PokerbotSharedSegment* segment,
+                                    int64_t ticket, double timeout_ms) {
+  if (!segment || ticket <= 0 || ticket > UINT32_MAX) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    return segment->impl->WaitCheckpoint(static_cast<uint32_t>(ticket),
+                                         timeout_ms)
+               ? POKERBOT_OK
+               : POKERBOT_ERR_TIMEOUT;
+  } catch (...) {
+    return POKERBOT_ERR_IO;
+  }
+}
+
+int pokerbot_shared_load_checkpoint(PokerbotSharedSegment* segment,
+                                    const char* path) {
+  if (!segment || !path) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    segment->impl->LoadCheckpoint(path);
+    return POKERBOT_OK;
+  } catch (...) {
+    return POKERBOT_ERR_IO;
+  }
+}
+
+int pokerbot_combo_count() {
+  return pokerbot::core::kNumCombos;
+}
+
+int pokerbot_combo_index(int card_a, int card_b) {
+  if (card_a < 0 || card_a >= kDeckSize || card_b < 0 || card_b >= kDeckSize ||
+      card_a == card_b) {
+    return -1;
+  }
+  return pokerbot::core::ComboIndex(static_cast<uint8_t>(card_a),
+                                    static_cast<uint8_t>(card_b));
+}
+
+int pokerbot_combo_cards(int index, uint8_t* out) {
+  if (!out || index < 0 || index >= pokerbot::core::kNumCombos) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const auto& cards = pokerbot::core::ComboCards(index);
+  out[0] = cards[0];
+  out[1] = cards[1];
+  return POKERBOT_OK;
+}
+
+PokerbotRange* pokerbot_range_create() {
+  try {
+    return new PokerbotRange();
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_range_destroy(PokerbotRange* range) {
+  delete range;
+}
+
+void pokerbot_range_reset(PokerbotRange* range) {
+  if (range) {
+    range->impl.Reset();
+  }
+}
+
+int pokerbot_range_remove_cards(PokerbotRange* range, const uint8_t* cards,
+                                int count) {
+  if (!range || count < 0 || (count > 0 && !cards)) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  uint64_t mask = 0;
+  for (int i = 0; i < count; ++i) {
+    if (cards[i] >= kDeckSize) {
+      return POKERBOT_ERR_INVALID_ARGUMENT;
+    }
+    mask |= uint64_t{1} << cards[i];
+  }
+  range->impl.RemoveCards(mask);
+  return POKERBOT_OK;
+}
+
+int pokerbot_range_update(PokerbotRange* range, const float* likelihood) {
+  if (!range || !likelihood) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  return range->impl.Update(likelihood) ? POKERBOT_OK
+                                        : POKERBOT_ERR_EMPTY_RANGE;
+}
+
+int pokerbot_range_observe_cfr(PokerbotRange* range,
+                               const PokerbotCfrTrainer* trainer,
+                               const PokerbotGameState* state, int observer) {
+  if (!range || !trainer || !state || observer < 0 || observer >= kNumPlayers) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    const bool consistent = range->impl.Observe(
+        state->impl, observer,
+        [&](const GameState& before, ActionType action, float* out) {
+          trainer->impl.ActionLikelihoods(before, action, out);
+        });
+    return consistent ? POKERBOT_OK : POKERBOT_ERR_EMPTY_RANGE;
+  } catch (const std::invalid_argument&) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+double pokerbot_range_total(const PokerbotRange* range) {
+  return range ? range->impl.total() : 0.0;
+}
+
+int pokerbot_range_weights(const PokerbotRange* range, float* out,
+                           int normalized) {
+  if (!range || !out) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  if (normalized) {
+    range->impl.Normalized(out);
+  } else {
+    std::copy(range->impl.weights(),
+              range->impl.weights() + pokerbot::core::kNumCombos, out);
+  }
+  return POKERBOT_OK;
+}
+
+int pokerbot_cfr_action_likelihoods(const PokerbotCfrTrainer* trainer,
+                                    const PokerbotGameState* state,
+                                    int action, float* out) {
+  if (!trainer || !state || !out || action < 0 ||
+      action >= pokerbot::core::kNumActionTypes) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    trainer->impl.ActionLikelihoods(state->impl,
+                                    static_cast<ActionType>(action), out);
+    return POKERBOT_OK;
+  } catch (const std::invalid_argument&) {
+    return POKERBOT_ERR_ILLEGAL_ACTION;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_ismcts_search(const PokerbotGameState* state, int num_threads,
+                           int64_t max_iterations, double time_budget_ms,
+                           uint64_t seed, int64_t* visits_out,
+                           double* values_out) {
+  if (!state) {
+    return -1;
+  }
+  try {
+    IsmctsOptions options;
+    options.num_threads = num_threads;
+    options.max_iterations = max_iterations;
+    options.time_budget_ms = time_budget_ms;
+    options.seed = seed;
+    const IsmctsResult result = pokerbot::core::RunIsmcts(state->impl, options);
+    if (visits_out) {
+      std::fill(visits_out, visits_out + pokerbot::core::kNumActionTypes, 0);
+    }
+    if (values_out) {
+      std::fill(values_out, values_out + pokerbot::core::kNumActionTypes, 0.0);
+    }
+    for (const auto& stats : result.actions) {
+      const int code = static_cast<int>(stats.action);
+      if (visits_out) {
+        visits_out[code] = stats.visits;
+      }
+      if (values_out) {
+        values_out[code] = stats.mean_value;
+      }
+    }
+    return static_cast<int>(result.best_action);
+  } catch (...) {
+    return -1;
+  }
+}
+
+int pokerbot_thread_pool_configure(int num_threads, int pin_threads,
+                                   int numa_policy) {
+  if (num_threads < 0 || numa_policy < 0 || numa_policy > 2) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  try {
+    ThreadPoolOptions options;
+    options.num_threads = num_threads;
+    options.pin_threads = pin_threads != 0;
+    options.numa_policy = static_cast<NumaPolicy>(numa_policy);
+    pokerbot::core::ConfigureDefaultThreadPool(options);
+    return POKERBOT_OK;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_thread_pool_size() {
+  try {
+    return pokerbot::core::DefaultThreadPool()->num_threads();
+  } catch (...) {
+    return 0;
+  }
+}
+
+uint64_t pokerbot_task_seed(uint64_t base_seed, uint64_t index) {
+  return ThreadPool::TaskSeed(base_seed, index);
+}
+
+int pokerbot_parallel_for(int64_t begin, int64_t end, int64_t grain,
+                          PokerbotRangeFn fn, void* user_data) {
+  if (!fn || begin < 0 || end < begin || grain < 0) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  std::atomic<bool> aborted{false};
+  try {
+    pokerbot::core::DefaultThreadPool()->ParallelFor(
+        static_cast<size_t>(begin), static_cast<size_t>(end),
+        static_cast<size_t>(grain), [&](size_t lo, size_t hi) {
+          if (fn(static_cast<int64_t>(lo), static_cast<int64_t>(hi),
+                 user_data) != 0) {
+            aborted.store(true, std::memory_order_relaxed);
+            throw std::runtime_error("Range callback aborted");
+          }
+        });
+    return POKERBOT_OK;
+  } catch (...) {
+    return aborted.load(std::memory_order_relaxed) ? POKERBOT_STOPPED
+                                                   : POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_parallel_sum(int64_t begin, int64_t end, int64_t grain,
+                          PokerbotRangeSumFn fn, void* user_data,
+                          double* out) {
+  if (!fn || !out || begin < 0 || end < begin || grain < 0) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  std::atomic<bool> aborted{false};
+  try {
+    *out = pokerbot::core::DefaultThreadPool()->ParallelReduce(
+        static_cast<size_t>(begin), static_cast<size_t>(end),
+        static_cast<size_t>(grain), 0.0,
+        [&](size_t lo, size_t hi) {
+          double value = 0.0;
+          if (fn(static_cast<int64_t>(lo), static_cast<int64_t>(hi), &value,
+                 user_data) != 0) {
+            aborted.store(true, std::memory_order_relaxed);
+            throw std::runtime_error("Range callback aborted");
+          }
+          return value;
+        },
+        [](double a, double b) { return a + b; });
+    return POKERBOT_OK;
+  } catch (...) {
+    return aborted.load(std::memory_order_relaxed) ? POKERBOT_STOPPED
+                                                   : POKERBOT_ERR_INTERNAL;
+  }
+}
+
+int pokerbot_observation_size() { return pokerbot::core::kObservationSize; }
+
+int pokerbot_scheduler_batch_snapshot(const PokerbotInferenceBatch* batch,
+                                      int index, uint8_t* out) {
+  if (!batch || !out || index < 0 || index >= batch->impl.size) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  const GameSnapshot snapshot = batch->impl.states[index]->Snapshot();
+  std::memcpy(out, &snapshot, sizeof(snapshot));
+  return POKERBOT_OK;
+}
+
+void pokerbot_scheduler_default_options(PokerbotSchedulerOptions* out) {
+  if (!out) {
+    return;
+  }
+  const InferenceSchedulerOptions defaults;
+  out->num_hands = defaults.num_hands;
+  out->concurrent_hands = defaults.concurrent_hands;
+  out->max_batch_size = defaults.max_batch_size;
+  out->max_wait_ms = defaults.max_wait_ms;
+  out->seed = defaults.seed;
+}
+
+int pokerbot_scheduler_run(const PokerbotSchedulerOptions* options,
+                           PokerbotBatchPolicy policy, PokerbotHandSink sink,
+                           void* user_data, int64_t* stats_out) {
+  if (!options || !policy) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  InferenceSchedulerOptions converted;
+  converted.num_hands = options->num_hands;
+  converted.concurrent_hands = options->concurrent_hands;
+  converted.max_batch_size = options->max_batch_size;
+  converted.max_wait_ms = options->max_wait_ms;
+  converted.seed = options->seed;
+  bool aborted = false;
+  try {
+    InferenceScheduler scheduler(pokerbot::core::GameConfig(), converted);
+    const InferenceSchedulerStats stats = scheduler.Run(
+        [&](const InferenceBatch& batch, float* probabilities) {
+          // Snapshots are taken on demand, so policies that only read the
+          // observations pay nothing for them.
+          const PokerbotInferenceBatch handle{batch};
+          if (policy(&handle, batch.size, batch.observations,
+                     batch.legal_masks, probabilities, user_data) != 0) {
+            aborted = true;
+            throw std::runtime_error("Batch policy aborted");
+          }
+        },
+        [&](int64_t hand_index, const GameState& final_state) {
+          if (!sink) {
+            return;
+          }
+          const GameSnapshot snapshot = final_state.Snapshot();
+          const auto payoffs = final_state.payoffs();
+          if (sink(hand_index, reinterpret_cast<const uint8_t*>(&snapshot),
+                   payoffs.data(), user_data) != 0) {
+            aborted = true;
+            throw std::runtime_error("Hand sink aborted");
+          }
+        });
+    if (stats_out) {
+      stats_out[0] = stats.hands;
+      stats_out[1] = stats.decisions;
+      stats_out[2] = stats.batches;
+      stats_out[3] = stats.largest_batch;
+      stats_out[4] = stats.payoff_sum[0];
+      stats_out[5] = stats.payoff_sum[1];
+    }
+    return POKERBOT_OK;
+  } catch (const std::invalid_argument&) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  } catch (...) {
+    return aborted ? POKERBOT_STOPPED : POKERBOT_ERR_INTERNAL;
+  }
+}
+
+PokerbotHandHistoryWriter* pokerbot_history_writer_open(const char* path,
+                                                        int block_bytes,
+                                                        int store_full_deck) {
+  if (!path) {
+    return nullptr;
+  }
+  try {
+    HandHistoryWriterOptions options;
+    if (block_bytes > 0) {
+      options.block_bytes = static_cast<size_t>(block_bytes);
+    }
+    options.store_full_deck = store_full_deck != 0;
+    auto writer = std::make_unique<PokerbotHandHistoryWriter>();
+    writer->impl = std::make_unique<HandHistoryWriter>(
+        path, pokerbot::core::GameConfig(), options);
+    return writer.release();
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+int pokerbot_history_writer_append_state(PokerbotHandHistoryWriter* writer,
+                                         const PokerbotGameState* state,
+                                         uint64_t hand_id) {
+  if (!writer || !state) {
+    return 0;
+  }
+  try {
+    writer->impl->Append(state->impl, hand_id);
+    return 1;
+  } catch (...) {
+    return 0;
+  }
+}
+
+int pokerbot_history_writer_flush(PokerbotHandHistoryWriter* writer) {
+  if (!writer) {
+    return 0;
+  }
+  try {
+    writer->impl->Flush();
+    return 1;
+  } catch (...) {
+    return 0;
+  }
+}
+
+int pokerbot_history_writer_close(PokerbotHandHistoryWriter* writer) {
+  if (!writer) {
+    return 0;
+  }
+  int ok = 1;
+  try {
+    writer->impl->Close();
+  } catch (...) {
+    ok = 0;
+  }
+  delete writer;
+  return ok;
+}
+
+PokerbotHandHistoryReader* pokerbot_history_reader_open(const char* path) {
+  if (!path) {
+    return nullptr;
+  }
+  try {
+    auto reader = std::make_unique<PokerbotHandHistoryReader>();
+    reader->impl = std::make_unique<HandHistoryReader>(path);
+    return reader.release();
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_history_reader_close(PokerbotHandHistoryReader* reader) {
+  delete reader;
+}
+
+int64_t pokerbot_history_reader_size(const PokerbotHandHistoryReader* reader) {
+  return reader ? static_cast<int64_t>(reader->impl->size()) : 0;
+}
+
+int pokerbot_history_reader_read(const PokerbotHandHistoryReader* reader,
+                                 int64_t index, uint64_t* hand_id_out,
+                                 uint8_t* deck_out, int64_t* payoffs_out,
+                                 int* actions_out, int max_actions) {
+  if (!reader || index < 0) {
+    return -1;
+  }
+  try {
+    const HandRecord record = reader->impl->Read(static_cast<size_t>(index));
+    return CopyRecord(record, hand_id_out, deck_out, payoffs_out, actions_out,
+                      max_actions);
+  } catch (...) {
+    return -1;
+  }
+}
+
+PokerbotHistoryCursor* pokerbot_history_cursor_open(
+    const PokerbotHandHistoryReader* reader, int64_t start) {
+  if (!reader || start < 0) {
+    return nullptr;
+  }
+  try {
+    return new PokerbotHistoryCursor{
+        HandHistoryCursor(*reader->impl, static_cast<size_t>(start)),
+        HandRecord()};
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void pokerbot_history_cursor_close(PokerbotHistoryCursor* cursor) {
+  delete cursor;
+}
+
+int pokerbot_history_cursor_next(PokerbotHistoryCursor* cursor,
+                                 uint64_t* hand_id_out, uint8_t* deck_out,
+                                 int64_t* payoffs_out, int* actions_out,
+                                 int max_actions) {
+  if (!cursor) {
+    return -2;
+  }
+  try {
+    if (!cursor->impl.Next(&cursor->record)) {
+      return -1;
+    }
+    return CopyRecord(cursor->record, hand_id_out, deck_out, payoffs_out,
+                      actions_out, max_actions);
+  } catch (...) {
+    return -2;
+  }
+}
+
+int64_t pokerbot_history_reader_for_each(
+    const PokerbotHandHistoryReader* reader, PokerbotHistoryRecordFn predicate,
+    PokerbotHistoryRecordFn visitor, void* user_data) {
+  if (!reader || !visitor) {
+    return -1;
+  }
+  try {
+    std::vector<int> actions;
+    const auto accept = [&](const HandRecord& record) {
+      return !predicate ||
+             CallRecordFn(predicate, record, &actions, user_data) != 0;
+    };
+    const auto visit = [&](const HandRecord& record) {
+      return CallRecordFn(visitor, record, &actions, user_data) == 0;
+    };
+    return static_cast<int64_t>(reader->impl->ForEach(accept, visit));
+  } catch (...) {
+    return -1;
+  }
+}
+
+int pokerbot_replay_history(const char* path, int num_threads,
+                            int64_t* summary_out, int64_t* failures_out,
+                            int max_failures) {
+  if (!path) {
+    return -1;
+  }
+  try {
+    HandHistoryReader reader(path);
+    ReplayOptions options;
+    options.num_threads = num_threads;
+    options.ordered = true;
+    options.failures_only = true;
+    int written = 0;
+    const ReplaySummary summary = pokerbot::core::ReplayHistory(
+        reader, options, [&](const ReplayResult& result) {
+          if (failures_out && written < max_failures) {
+            failures_out[written++] = static_cast<int64_t>(result.index);
+          }
+        });
+    CopyReplaySummary(summary, summary_out);
+    return written;
+  } catch (...) {
+    return -1;
+  }
+}
+
+int pokerbot_replay_run(const char* path, const PokerbotReplayOptions* options,
+                        PokerbotReplayResultFn on_result,
+                        PokerbotReplayDecisionFn on_decision, void* user_data,
+                        int64_t* summary_out) {
+  if (!path || !options || options->num_threads < 0 ||
+      options->max_buffered_blocks < 0) {
+    return POKERBOT_ERR_INVALID_ARGUMENT;
+  }
+  std::atomic<bool> aborted{false};
+  try {
+    HandHistoryReader reader(path);
+    ReplayOptions converted;
+    converted.num_threads = options->num_threads;
+    converted.ordered = options->ordered != 0;
+    converted.failures_only = options->failures_only != 0;
+    converted.max_buffered_blocks = options->max_buffered_blocks;
+    ReplayResultSink sink;
+    if (on_result) {
+      sink = [&](const ReplayResult& result) {
+        if (on_result(static_cast<int64_t>(result.index), result.hand_id,
+                      static_cast<int>(result.status), result.failed_action,
+                      result.replayed_payoffs.data(), user_data) != 0) {
+          aborted = true;
+          throw std::runtime_error("Replay result callback aborted");
+        }
+      };
+    }
+    ReplayDecisionVisitor visitor;
+    if (on_decision) {
+      visitor = [&](size_t index, const GameState& state,
+                    const ActionLogEntry& action) {
+        const GameSnapshot snapshot = state.Snapshot();
+        if (on_decision(static_cast<int64_t>(index),
+                        reinterpret_cast<const uint8_t*>(&snapshot),
+                        static_cast<int>(action.action), user_data) != 0) {
+          aborted = true;
+          throw std::runtime_error("Replay decision callback aborted");
+        }
+      };
+    }
+    const ReplaySummary summary =
+        pokerbot::core::ReplayHistory(reader, converted, sink, visitor);
+    CopyReplaySummary(summary, summary_out);
+    return POKERBOT_OK;
+  } catch (const std::runtime_error&) {
+    // Unreadable or corrupt files surface as runtime errors.
+    return aborted ? POKERBOT_STOPPED : POKERBOT_ERR_IO;
+  } catch (...) {
+    return POKERBOT_ERR_INTERNAL;
+  }
+}
+
 }  // extern "C"
@@ -7,6 +7,14 @@
 extern "C" {
 
 struct PokerbotGameState;
+struct PokerbotStatePool;
+struct PokerbotCfrTrainer;
+struct PokerbotSharedSegment;
+struct PokerbotRange;
+struct PokerbotHandHistoryWriter;
+struct PokerbotHandHistoryReader;
+struct PokerbotHistoryCursor;
+struct PokerbotInferenceBatch;
 
 enum PokerbotAction : int {
   POKERBOT_ACTION_FOLD = static_cast<int>(pokerbot::core::ActionType::kFold),
@@ -16,12 +24,85 @@ enum PokerbotAction : int {
   POKERBOT_ACTION_RAISE = static_cast<int>(pokerbot::core::ActionType::kRaise),
 };
 
+enum PokerbotStatus : int {
+  POKERBOT_OK = 0,
+  POKERBOT_ERR_INVALID_ARGUMENT = 1,
+  POKERBOT_ERR_INVALID_HANDLE = 2,
+  POKERBOT_ERR_POOL_EXHAUSTED = 3,
+  POKERBOT_ERR_ILLEGAL_ACTION = 4,
+  POKERBOT_ERR_INTERNAL = 5,
+  POKERBOT_ERR_TIMEOUT = 6,
+  POKERBOT_ERR_IO = 7,
+  // Not an error: the coordinator asked shared-training workers to stop, or
+  // a scheduler callback asked the run to end.
+  POKERBOT_STOPPED = 8,
+  // Evidence no live holding can explain; the range was left unchanged.
+  POKERBOT_ERR_EMPTY_RANGE = 9,
+};
+
+// Flat per-state summary filled by pokerbot_pool_query.
+struct PokerbotStateInfo {
+  int32_t current_player;
+  int32_t betting_round;
+  int32_t is_terminal;
+  int32_t terminal_reason;
+  int32_t winner;
+  int32_t board_count;
+  uint32_t legal_action_mask;  // Bit i set when action code i is legal.
+  int32_t reserved;
+  int64_t pot;
+  int64_t to_call;  // For the player to act; 0 when terminal.
+  int64_t payoffs[2];
+};
+
+// Mirrors pokerbot::core::CfrOptions; fill with pokerbot_cfr_default_options.
+struct PokerbotCfrOptions {
+  int32_t variant;  // 0 vanilla, 1 CFR+, 2 linear, 3 discounted.
+  int32_t alternating_updates;
+  int32_t regret_pruning;
+  int32_t reserved;
+  double alpha;
+  double beta;
+  double gamma;
+  double prune_threshold;
+  int64_t discount_interval;
+  int64_t prune_warmup_iterations;
+  int64_t prune_recheck_interval;
+  int64_t table_capacity;
+  uint64_t seed;
+};
+
+// Mirrors pokerbot::core::InferenceSchedulerOptions; fill with
+// pokerbot_scheduler_default_options.
+struct PokerbotSchedulerOptions {
+  int64_t num_hands;
+  int32_t concurrent_hands;
+  int32_t max_batch_size;
+  double max_wait_ms;
+  uint64_t seed;
+};
+
+// Scheduler callbacks; a nonzero return ends the run with POKERBOT_STOPPED.
+// The policy reads `batch_size` rows of pokerbot_observation_size() floats
+// and legal-action masks, and writes 5 probabilities per row indexed by
+// action code. `batch` is valid only during the call; pass it to
+// pokerbot_scheduler_batch_snapshot for the full state of a row.
+typedef int (*PokerbotBatchPolicy)(const PokerbotInferenceBatch* batch,
+                                   int batch_size, const float* observations,
+                                   const uint32_t* legal_masks,
+                                   float* probabilities, void* user_data);
+// Receives each finished hand's snapshot and payoffs (2 values).
+typedef int (*PokerbotHandSink)(int64_t hand_index, const uint8_t* snapshot,
+                                const int64_t* payoffs, void* user_data);
+
 PokerbotGameState* pokerbot_state_create();
 void pokerbot_state_destroy(PokerbotGameState* state);
 
 void pokerbot_state_reset(PokerbotGameState* state, uint64_t seed);
-void pokerbot_state_reset_with_deck(PokerbotGameState* state,
-                                    const uint8_t* deck, int deck_size);
+// Returns 1 on success, or 0 (leaving the state untouched) if the first 52
+// cards of `deck` are not a permutation of 0..51.
+int pokerbot_state_reset_with_deck(PokerbotGameState* state,
+                                   const uint8_t* deck, int deck_size);
 
 int pokerbot_state_current_player(const PokerbotGameState* state);
 int pokerbot_state_betting_round(const PokerbotGameState* state);
@@ -47,4 +128,283 @@ int pokerbot_state_apply_action(PokerbotGameState* state, int action);
 
 void pokerbot_state_payoffs(const PokerbotGameState* state, int64_t* out);
 
+// Hand value of `player`'s hole cards plus the exposed board; higher is
+// better. Returns 0 for an invalid player.
+uint64_t pokerbot_state_hand_strength(const PokerbotGameState* state,
+                                      int player);
+
+// Strongest 5-card value among `count` (5 to 7) cards, by exhaustive search.
+// Returns 0 for invalid input.
+uint64_t pokerbot_evaluate_best_hand(const uint8_t* cards, int count);
+// Same value through the incremental board evaluator: two hole cards plus
+// `board_count` (3 to 5) board cards. Returns 0 for invalid input.
+uint64_t pokerbot_evaluate_with_board(const uint8_t* hole_cards,
+                                      const uint8_t* board, int board_count);
+
+// Size in bytes of one packed state snapshot.
+int pokerbot_snapshot_size();
+// Writes `count` snapshots back to back into `out`
+// (count * pokerbot_snapshot_size() bytes). Returns the number written.
+int pokerbot_state_snapshot_batch(const PokerbotGameState* const* states,
+                                  int count, uint8_t* out);
+// Restores `count` states from snapshots laid out as above. Stops at the
+// first invalid snapshot and returns the number restored.
+int pokerbot_state_restore_batch(PokerbotGameState* const* states, int count,
+                                 const uint8_t* in);
+
+// Handle pool: a preallocated arena of `capacity` states addressed by
+// integer handles. Batch calls validate every handle and return a
+// PokerbotStatus; acquire/release may be called from any thread, but one
+// handle must not be used concurrently.
+PokerbotStatePool* pokerbot_pool_create(int capacity);
+void pokerbot_pool_destroy(PokerbotStatePool* pool);
+int pokerbot_pool_capacity(const PokerbotStatePool* pool);
+int pokerbot_pool_in_use(const PokerbotStatePool* pool);
+
+// All-or-nothing acquisition of `count` handles.
+int pokerbot_pool_acquire(PokerbotStatePool* pool, int count,
+                          uint64_t* handles_out);
+int pokerbot_pool_release(PokerbotStatePool* pool, const uint64_t* handles,
+                          int count);
+
+int pokerbot_pool_reset(PokerbotStatePool* pool, const uint64_t* handles,
+                        const uint64_t* seeds, int count);
+// `decks` holds `count` consecutive 52-card decks. If any deck is not a
+// permutation of 0..51, no state is reset and INVALID_ARGUMENT is returned.
+int pokerbot_pool_reset_with_decks(PokerbotStatePool* pool,
+                                   const uint64_t* handles,
+                                   const uint8_t* decks, int count);
+// Applies actions[i] to handles[i]. `statuses_out` (optional) receives a
+// per-state status; the return value is the first non-OK status, if any.
+int pokerbot_pool_apply(PokerbotStatePool* pool, const uint64_t* handles,
+                        const int* actions, int count, int* statuses_out);
+int pokerbot_pool_query(const PokerbotStatePool* pool,
+                        const uint64_t* handles, int count,
+                        PokerbotStateInfo* out);
+
+// Native CFR trainer. Calls return a PokerbotStatus.
+void pokerbot_cfr_default_options(PokerbotCfrOptions* out);
+// `options` may be null for defaults.
+PokerbotCfrTrainer* pokerbot_cfr_create(const PokerbotCfrOptions* options);
+void pokerbot_cfr_destroy(PokerbotCfrTrainer* trainer);
+int pokerbot_cfr_run(PokerbotCfrTrainer* trainer, int64_t iterations);
+// `out` receives {iterations, infosets, nodes_visited, actions_pruned}.
+int pokerbot_cfr_stats(const PokerbotCfrTrainer* trainer, int64_t* out);
+// Average strategy for the player to act in `state`, indexed by action code
+// (5 entries, zero for illegal actions).
+int pokerbot_cfr_average_strategy(const PokerbotCfrTrainer* trainer,
+                                  const PokerbotGameState* state,
+                                  double* out);
+// Raw accumulators of the information set for the player to act, indexed
+// by action code like pokerbot_cfr_average_strategy; zero when unvisited.
+// Either output may be null.
+int pokerbot_cfr_infoset(const PokerbotCfrTrainer* trainer,
+                         const PokerbotGameState* state, double* regrets_out,
+                         double* strategy_sums_out);
+// Applies the table-wide discounts for the interval boundaries in
+// (from_iteration, to_iteration]; a no-op for vanilla CFR and CFR+.
+int pokerbot_cfr_apply_discounts(PokerbotCfrTrainer* trainer,
+                                 int64_t from_iteration, int64_t to_iteration);
+// Restricts chance to `count` decks of 52 cards each, sampled uniformly;
+// zero decks restore shuffling.
+int pokerbot_cfr_set_deals(PokerbotCfrTrainer* trainer, const uint8_t* decks,
+                           int count);
+// NashConv of the average strategy, in chips per hand, over the game whose
+// chance outcomes are exactly the `count` given decks.
+int pokerbot_cfr_exploitability(const PokerbotCfrTrainer* trainer,
+                                const uint8_t* decks, int count,
+                                double* out);
+
+// Multi-process training over a named POSIX shared-memory regret table. The
+// coordinator creates the segment (and unlinks it on close); each of
+// `num_workers` worker processes attaches by name, creates a trainer on it
+// with its own seed, and calls pokerbot_cfr_run_shared_round in a loop until
+// it returns POKERBOT_STOPPED. A non-positive timeout waits forever.
+PokerbotSharedSegment* pokerbot_shared_create(const char* name,
+                                              int64_t capacity,
+                                              int num_workers);
+PokerbotSharedSegment* pokerbot_shared_attach(const char* name);
+void pokerbot_shared_close(PokerbotSharedSegment* segment);
+// Global iterations completed as of the last round barrier.
+int64_t pokerbot_shared_iteration(const PokerbotSharedSegment* segment);
+int pokerbot_shared_request_stop(PokerbotSharedSegment* segment);
+// Asks the next round barrier to write a checkpoint. Returns a ticket
+// (> 0), 0 while an earlier request is pending, or -1 on bad arguments.
+int64_t pokerbot_shared_request_checkpoint(PokerbotSharedSegment* segment,
+                                           const char* path);
+int pokerbot_shared_wait_checkpoint(const PokerbotSharedSegment* segment,
+                                    int64_t ticket, double timeout_ms);
+// Restores a checkpoint into the table; call before workers start.
+int pokerbot_shared_load_checkpoint(PokerbotSharedSegment* segment,
+                                    const char* path);
+// Trainer over the segment's table; the segment must outlive it.
+PokerbotCfrTrainer* pokerbot_cfr_create_shared(
+    const PokerbotCfrOptions* options, PokerbotSharedSegment* segment);
+int pokerbot_cfr_run_shared_round(PokerbotCfrTrainer* trainer,
+                                  PokerbotSharedSegment* segment,
+                                  int64_t iterations, double timeout_ms);
+
+// Opponent range over the 1326 two-card holdings, indexed by
+// pokerbot_combo_index. Weight arrays hold 1326 floats.
+int pokerbot_combo_count();
+// Index of the holding {a, b}, or -1 for invalid or equal cards.
+int pokerbot_combo_index(int card_a, int card_b);
+// Writes the two cards (lower first) of holding `index`. Returns a status.
+int pokerbot_combo_cards(int index, uint8_t* out);
+
+PokerbotRange* pokerbot_range_create();
+void pokerbot_range_destroy(PokerbotRange* range);
+void pokerbot_range_reset(PokerbotRange* range);
+// Zeroes every holding containing one of `cards`.
+int pokerbot_range_remove_cards(PokerbotRange* range, const uint8_t* cards,
+                                int count);
+// Multiplies in per-holding action probabilities.
+int pokerbot_range_update(PokerbotRange* range, const float* likelihood);
+// Folds in the board and the opponent actions of `state` not yet observed,
+// scoring each action with the trainer's average strategy.
+int pokerbot_range_observe_cfr(PokerbotRange* range,
+                               const PokerbotCfrTrainer* trainer,
+                               const PokerbotGameState* state, int observer);
+double pokerbot_range_total(const PokerbotRange* range);
+// Copies the weights, normalized to sum to one when `normalized` is set.
+int pokerbot_range_weights(const PokerbotRange* range, float* out,
+                           int normalized);
+// Per-holding probability that the trainer's average strategy plays
+// `action` at `state`.
+int pokerbot_cfr_action_likelihoods(const PokerbotCfrTrainer* trainer,
+                                    const PokerbotGameState* state,
+                                    int action, float* out);
+
+// Runs ISMCTS for the player to act. `visits_out` and `values_out`
+// (optional) are indexed by action code and must hold 5 entries; actions that
+// are not legal report zero. Returns the chosen action code, or -1 on error.
+int pokerbot_ismcts_search(const PokerbotGameState* state, int num_threads,
+                           int64_t max_iterations, double time_budget_ms,
+                           uint64_t seed, int64_t* visits_out,
+                           double* values_out);
+
+// Shared worker pool used by replay, search and training. `num_threads` is
+// total concurrency including the caller (0 = hardware concurrency);
+// `numa_policy` is 0 (none), 1 (compact) or 2 (spread). Returns a
+// PokerbotStatus.
+int pokerbot_thread_pool_configure(int num_threads, int pin_threads,
+                                   int numa_policy);
+int pokerbot_thread_pool_size();
+// Deterministic per-task seed for GameState resets in parallel jobs.
+uint64_t pokerbot_task_seed(uint64_t base_seed, uint64_t index);
+
+// Chunk callbacks for the pool's loops; they run on pool workers and the
+// calling thread, and a nonzero return stops the loop with POKERBOT_STOPPED.
+// A callback may itself start a nested loop.
+typedef int (*PokerbotRangeFn)(int64_t begin, int64_t end, void* user_data);
+typedef int (*PokerbotRangeSumFn)(int64_t begin, int64_t end,
+                                  double* value_out, void* user_data);
+// ThreadPool::ParallelFor over [begin, end) in chunks of `grain` indices.
+int pokerbot_parallel_for(int64_t begin, int64_t end, int64_t grain,
+                          PokerbotRangeFn fn, void* user_data);
+// ThreadPool::ParallelReduce summing the chunk values in index order, so
+// `out` does not depend on the pool size.
+int pokerbot_parallel_sum(int64_t begin, int64_t end, int64_t grain,
+                          PokerbotRangeSumFn fn, void* user_data,
+                          double* out);
+
+// Batched self-play: plays options->num_hands hands, keeping up to
+// concurrent_hands in flight and calling `policy` once per batch of parked
+// decisions. Callbacks run on the calling thread; `sink` is optional.
+// `stats_out` (optional) receives {hands, decisions, batches, largest_batch,
+// payoff_sum0, payoff_sum1}. Returns a PokerbotStatus.
+int pokerbot_observation_size();
+void pokerbot_scheduler_default_options(PokerbotSchedulerOptions* out);
+int pokerbot_scheduler_run(const PokerbotSchedulerOptions* options,
+                           PokerbotBatchPolicy policy, PokerbotHandSink sink,
+                           void* user_data, int64_t* stats_out);
+// Writes the snapshot (pokerbot_snapshot_size() bytes) of row `index` of
+// the batch a policy is being called with. Returns a PokerbotStatus.
+int pokerbot_scheduler_batch_snapshot(const PokerbotInferenceBatch* batch,
+                                      int index, uint8_t* out);
+
+// Binary hand history. Writers return nullptr / 0 on failure.
+PokerbotHandHistoryWriter* pokerbot_history_writer_open(const char* path,
+                                                        int block_bytes,
+                                                        int store_full_deck);
+int pokerbot_history_writer_append_state(PokerbotHandHistoryWriter* writer,
+                                         const PokerbotGameState* state,
+                                         uint64_t hand_id);
+int pokerbot_history_writer_flush(PokerbotHandHistoryWriter* writer);
+// Flushes, closes and frees the writer. Returns 0 if the final write failed.
+int pokerbot_history_writer_close(PokerbotHandHistoryWriter* writer);
+
+PokerbotHandHistoryReader* pokerbot_history_reader_open(const char* path);
+void pokerbot_history_reader_close(PokerbotHandHistoryReader* reader);
+int64_t pokerbot_history_reader_size(const PokerbotHandHistoryReader* reader);
+// Decodes record `index`. `deck_out` receives 52 cards, `payoffs_out` two
+// values and `actions_out` up to `max_actions` action codes. Returns the
+// number of actions in the record, or -1 on error.
+int pokerbot_history_reader_read(const PokerbotHandHistoryReader* reader,
+                                 int64_t index, uint64_t* hand_id_out,
+                                 uint8_t* deck_out, int64_t* payoffs_out,
+                                 int* actions_out, int max_actions);
+
+// Sequential iteration that decodes each block once; prefer it to
+// pokerbot_history_reader_read for scans. The reader must outlive the cursor.
+PokerbotHistoryCursor* pokerbot_history_cursor_open(
+    const PokerbotHandHistoryReader* reader, int64_t start);
+void pokerbot_history_cursor_close(PokerbotHistoryCursor* cursor);
+// Decodes the next record into the buffers described above. Returns its
+// action count, -1 at the end of the file, or -2 on a corrupt block.
+int pokerbot_history_cursor_next(PokerbotHistoryCursor* cursor,
+                                 uint64_t* hand_id_out, uint8_t* deck_out,
+                                 int64_t* payoffs_out, int* actions_out,
+                                 int max_actions);
+
+// Receives one decoded record: 52 deck cards, 2 payoffs and `action_count`
+// action codes.
+typedef int (*PokerbotHistoryRecordFn)(uint64_t hand_id, const uint8_t* deck,
+                                       const int64_t* payoffs,
+                                       const int* actions, int action_count,
+                                       void* user_data);
+// Scans the file in order, handing `visitor` each record that `predicate`
+// (optional) accepts by returning nonzero. The visitor returns nonzero to
+// stop early. Returns the number of records visited, or -1 on error.
+int64_t pokerbot_history_reader_for_each(
+    const PokerbotHandHistoryReader* reader, PokerbotHistoryRecordFn predicate,
+    PokerbotHistoryRecordFn visitor, void* user_data);
+
+// Re-simulates every hand in a history file across `num_threads` workers
+// (0 = all cores). `summary_out` receives {hands, ok, illegal_action,
+// payoff_mismatch, incomplete}; the indices of the first `max_failures`
+// failing records are written to `failures_out` in file order. Returns the
+// number of indices written, or -1 on error.
+int pokerbot_replay_history(const char* path, int num_threads,
+                            int64_t* summary_out, int64_t* failures_out,
+                            int max_failures);
+
+// Mirrors pokerbot::core::ReplayOptions.
+struct PokerbotReplayOptions {
+  int32_t num_threads;
+  int32_t ordered;        // Deliver results in file order.
+  int32_t failures_only;  // Only deliver hands that failed to verify.
+  int32_t max_buffered_blocks;
+};
+
+// Receives one replay result; `status` is 0 ok, 1 illegal action, 2 payoff
+// mismatch, 3 incomplete. Calls are serialized.
+typedef int (*PokerbotReplayResultFn)(int64_t index, uint64_t hand_id,
+                                      int status, int failed_action,
+                                      const int64_t* replayed_payoffs,
+                                      void* user_data);
+// Receives the packed snapshot of each decision and the logged action about
+// to be applied. Called from worker threads, possibly concurrently.
+typedef int (*PokerbotReplayDecisionFn)(int64_t index, const uint8_t* snapshot,
+                                        int action, void* user_data);
+
+// Replays a history file with explicit options. Both callbacks are optional;
+// a nonzero return from either stops the replay with POKERBOT_STOPPED.
+// `summary_out` (optional) is filled as for pokerbot_replay_history.
+// Returns a PokerbotStatus.
+int pokerbot_replay_run(const char* path, const PokerbotReplayOptions* options,
+                        PokerbotReplayResultFn on_result,
+                        PokerbotReplayDecisionFn on_decision, void* user_data,
+                        int64_t* summary_out);
+
 }
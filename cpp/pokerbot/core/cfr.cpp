@@ -0,0 +1,397 @@
+#include "cfr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "opponent_range.h"
+
+namespace pokerbot::core {
+namespace {
+
+constexpr int kPreflopBuckets = 169;
+// Postflop buckets: nine made-hand categories times the top rank.
+constexpr int kNumBuckets = kPreflopBuckets + 9 * kRanks;
+constexpr size_t kInitialStackDepth = 64;
+
+uint64_t Mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+int HandBucket(const GameState& state, const std::array<uint8_t, 2>& hole) {
+  if (state.board_card_count() == 0) {
+    const int hi = std::max(Rank(hole[0]), Rank(hole[1]));
+    const int lo = std::min(Rank(hole[0]), Rank(hole[1]));
+    if (hi == lo) {
+      return hi;
+    }
+    const int suited = Suit(hole[0]) == Suit(hole[1]) ? 1 : 0;
+    return kRanks + (hi * (hi - 1) / 2 + lo) * 2 + suited;
+  }
+  const uint64_t value = state.HandStrength(hole);
+  const int category = static_cast<int>(value >> 32);
+  const int top_rank = static_cast<int>((value >> 16) & 0xF);
+  return kPreflopBuckets + category * kRanks + top_rank;
+}
+
+// Regret matching over the first `count` entries.
+void CurrentStrategy(const double* regrets, int count, double* out) {
+  double positive_sum = 0.0;
+  for (int a = 0; a < count; ++a) {
+    out[a] = std::max(0.0, regrets[a]);
+    positive_sum += out[a];
+  }
+  for (int a = 0; a < count; ++a) {
+    out[a] = positive_sum > 0.0 ? out[a] / positive_sum : 1.0 / count;
+  }
+}
+
+int LegalActionList(const GameState& state, ActionType* out) {
+  const uint32_t mask = state.LegalActionMask();
+  int count = 0;
+  for (int action = 0; action < kNumActionTypes; ++action) {
+    if ((mask & (1u << action)) != 0) {
+      out[count++] = static_cast<ActionType>(action);
+    }
+  }
+  return count;
+}
+
+// Hash of the public betting history.
+uint64_t HistoryKey(const GameState& state) {
+  uint64_t history = 0;
+  for (const ActionLogEntry& entry : state.action_history()) {
+    // Three symbols: fold, check/call, bet/raise.
+    uint64_t symbol = 0;
+    if (entry.action == ActionType::kCheck || entry.action == ActionType::kCall) {
+      symbol = 1;
+    } else if (entry.action == ActionType::kBet ||
+               entry.action == ActionType::kRaise) {
+      symbol = 2;
+    }
+    history = Mix(history * 3 + symbol + 1);
+  }
+  return history;
+}
+
+uint64_t CombineKey(uint64_t history, int bucket, const GameState& state) {
+  return Mix(history ^ (static_cast<uint64_t>(bucket) << 8) ^
+             (static_cast<uint64_t>(state.betting_round()) << 4) ^
+             static_cast<uint64_t>(state.current_player()));
+}
+
+}  // namespace
+
+CfrTrainer::CfrTrainer(GameConfig config, CfrOptions options)
+    : CfrTrainer(config, options, nullptr) {}
+
+CfrTrainer::CfrTrainer(GameConfig config, CfrOptions options,
+                       RegretTable* table)
+    : config_(config), options_(options), table_(table), rng_(options.seed) {
+  if (options_.discount_interval <= 0 || options_.prune_recheck_interval <= 0) {
+    throw std::invalid_argument("CfrOptions intervals must be positive");
+  }
+  if (!table_) {
+    owned_table_ = std::make_unique<RegretTable>(options_.table_capacity);
+    table_ = owned_table_.get();
+  }
+  stack_.assign(kInitialStackDepth, GameState(config_));
+}
+
+CfrStats CfrTrainer::stats() const {
+  CfrStats stats;
+  stats.iterations = iteration_;
+  stats.infosets = table_->size();
+  stats.nodes_visited = nodes_visited_;
+  stats.actions_pruned = actions_pruned_;
+  return stats;
+}
+
+uint64_t CfrTrainer::InfoSetKey(const GameState& state) const {
+  return CombineKey(HistoryKey(state),
+                    HandBucket(state, state.hole_cards(state.current_player())),
+                    state);
+}
+
+std::vector<double> CfrTrainer::AverageStrategy(const GameState& state) const {
+  ActionType actions[kMaxInfoSetActions];
+  const int count = LegalActionList(state, actions);
+  std::vector<double> strategy(count, count > 0 ? 1.0 / count : 0.0);
+  if (count == 0) {
+    return strategy;
+  }
+  const size_t slot = table_->Find(InfoSetKey(state));
+  if (slot == table_->capacity()) {
+    return strategy;
+  }
+  const double* sums = table_->strategy_sum(slot);
+  double total = 0.0;
+  for (int a = 0; a < count; ++a) {
+    total += std::max(0.0, sums[a]);
+  }
+  if (total > 0.0) {
+    for (int a = 0; a < count; ++a) {
+      strategy[a] = std::max(0.0, sums[a]) / total;
+    }
+  }
+  return strategy;
+}
+
+double CfrTrainer::AverageProbability(uint64_t key, int count,
+                                      int index) const {
+  const size_t slot = table_->Find(key);
+  if (slot == table_->capacity()) {
+    return 1.0 / count;
+  }
+  const double* sums = table_->strategy_sum(slot);
+  double total = 0.0;
+  for (int a = 0; a < count; ++a) {
+    total += std::max(0.0, sums[a]);
+  }
+  return total > 0.0 ? std::max(0.0, sums[index]) / total : 1.0 / count;
+}
+
+void CfrTrainer::ActionLikelihoods(const GameState& state, ActionType action,
+                                   float* out) const {
+  ActionType actions[kMaxInfoSetActions];
+  const int count = LegalActionList(state, actions);
+  const int index =
+      static_cast<int>(std::find(actions, actions + count, action) - actions);
+  if (index == count) {
+    throw std::invalid_argument("Action is not legal in this state");
+  }
+  uint64_t board_mask = 0;
+  for (uint8_t card : state.board_cards()) {
+    board_mask |= uint64_t{1} << card;
+  }
+  const uint64_t history = HistoryKey(state);
+  // Holdings in the same bucket share an information set.
+  std::array<float, kNumBuckets> by_bucket;
+  by_bucket.fill(-1.0f);
+  for (int combo = 0; combo < kNumCombos; ++combo) {
+    const std::array<uint8_t, 2>& hole = ComboCards(combo);
+    if ((board_mask & ((uint64_t{1} << hole[0]) | (uint64_t{1} << hole[1]))) !=
+        0) {
+      out[combo] = 0.0f;
+      continue;
+    }
+    const int bucket = HandBucket(state, hole);
+    if (by_bucket[bucket] < 0.0f) {
+      by_bucket[bucket] = static_cast<float>(AverageProbability(
+          CombineKey(history, bucket, state), count, index));
+    }
+    out[combo] = by_bucket[bucket];
+  }
+}
+
+bool CfrTrainer::PruningActive() const {
+  return options_.regret_pruning &&
+         iteration_ >= options_.prune_warmup_iterations &&
+         iteration_ % options_.prune_recheck_interval != 0;
+}
+
+void CfrTrainer::RunIterations(int64_t iterations) {
+  for (int64_t i = 0; i < iterations; ++i) {
+    if (deals_.empty()) {
+      stack_[0].Reset(rng_());
+    } else {
+      stack_[0].ResetWithDeck(deals_[rng_() % deals_.size()]);
+    }
+    if (options_.alternating_updates) {
+      for (int player = 0; player < kNumPlayers; ++player) {
+        Traverse(0, player, {1.0, 1.0});
+      }
+    } else {
+      Traverse(0, -1, {1.0, 1.0});
+    }
+    ++iteration_;
+    if (!options_.defer_discount) {
+      ApplyDiscountsBetween(iteration_ - 1, iteration_);
+    }
+  }
+}
+
+void CfrTrainer::SetDeals(std::vector<std::array<uint8_t, kDeckSize>> deals) {
+  deals_ = std::move(deals);
+}
+
+void CfrTrainer::ApplyDiscountsBetween(int64_t from_iteration,
+                                       int64_t to_iteration) {
+  if (options_.variant != CfrVariant::kLinear &&
+      options_.variant != CfrVariant::kDiscounted) {
+    return;
+  }
+  const int64_t interval = options_.discount_interval;
+  for (int64_t boundary = (from_iteration / interval + 1) * interval;
+       boundary <= to_iteration; boundary += interval) {
+    ApplyDiscount(boundary);
+  }
+}
+
+void CfrTrainer::ApplyDiscount(int64_t iteration) {
+  const double t =
+      static_cast<double>(iteration / options_.discount_interval);
+  if (options_.variant == CfrVariant::kLinear) {
+    const double factor = t / (t + 1.0);
+    table_->Scale(factor, factor, factor);
+    return;
+  }
+  const double pos = std::pow(t, options_.alpha);
+  const double neg = std::pow(t, options_.beta);
+  table_->Scale(pos / (pos + 1.0), neg / (neg + 1.0),
+                std::pow(t / (t + 1.0), options_.gamma));
+}
+
+double CfrTrainer::Traverse(int depth, int update_player,
+                            const std::array<double, kNumPlayers>& reach) {
+  ++nodes_visited_;
+  if (stack_[depth].is_terminal()) {
+    return static_cast<double>(stack_[depth].payoffs()[0]);
+  }
+  if (static_cast<size_t>(depth + 1) >= stack_.size()) {
+    stack_.emplace_back(config_);
+  }
+
+  const int player = stack_[depth].current_player();
+  ActionType actions[kMaxInfoSetActions];
+  const int count = LegalActionList(stack_[depth], actions);
+  const size_t slot = table_->FindOrInsert(InfoSetKey(stack_[depth]));
+  double regrets[kMaxInfoSetActions];
+  table_->LoadRegrets(slot, regrets);
+
+  double strategy[kMaxInfoSetActions];
+  CurrentStrategy(regrets, count, strategy);
+
+  const bool updating = update_player == -1 || update_player == player;
+  const bool prune = PruningActive();
+  double values[kMaxInfoSetActions] = {0.0, 0.0, 0.0};
+  bool explored[kMaxInfoSetActions] = {false, false, false};
+  double node_value = 0.0;
+
+  for (int a = 0; a < count; ++a) {
+    // Opponent edges the strategy never takes have zero reach, so skipping
+    // them only drops the updating player's strategy sums below.
+    if (prune && strategy[a] == 0.0 &&
+        (!updating || regrets[a] <= options_.prune_threshold)) {
+      ++actions_pruned_;
+      continue;
+    }
+    stack_[depth + 1] = stack_[depth];
+    stack_[depth + 1].ApplyAction(actions[a]);
+    std::array<double, kNumPlayers> child_reach = reach;
+    child_reach[player] *= strategy[a];
+    values[a] = Traverse(depth + 1, update_player, child_reach);
+    explored[a] = true;
+    node_value += strategy[a] * values[a];
+  }
+
+  if (!updating) {
+    return node_value;
+  }
+
+  // Values are from player 0's perspective; flip for player 1.
+  const double sign = player == 0 ? 1.0 : -1.0;
+  const double opponent_reach = reach[1 - player];
+  const double strategy_weight =
+      options_.variant == CfrVariant::kCfrPlus
+          ? static_cast<double>(iteration_ + 1)
+          : 1.0;
+  for (int a = 0; a < count; ++a) {
+    if (explored[a]) {
+      const double delta = sign * (values[a] - node_value) * opponent_reach;
+      table_->AddRegret(slot, a, delta,
+                        options_.variant == CfrVariant::kCfrPlus);
+    }
+    table_->AddStrategySum(slot, a,
+                           reach[player] * strategy[a] * strategy_weight);
+  }
+  return node_value;
+}
+
+double CfrTrainer::Exploitability(
+    const std::vector<std::array<uint8_t, kDeckSize>>& deals) const {
+  if (deals.empty()) {
+    throw std::invalid_argument("Exploitability requires at least one deal");
+  }
+  std::vector<GameState> roots(deals.size(), GameState(config_));
+  for (size_t d = 0; d < deals.size(); ++d) {
+    roots[d].ResetWithDeck(deals[d]);
+  }
+  const std::vector<double> weights(deals.size(), 1.0 / deals.size());
+  double total = 0.0;
+  for (int player = 0; player < kNumPlayers; ++player) {
+    const std::vector<double> values = BestResponse(player, roots, weights);
+    for (size_t d = 0; d < deals.size(); ++d) {
+      total += weights[d] * values[d];
+    }
+  }
+  return total;
+}
+
+std::vector<double> CfrTrainer::BestResponse(
+    int player, const std::vector<GameState>& states,
+    const std::vector<double>& weights) const {
+  const size_t n = states.size();
+  std::vector<double> values(n, 0.0);
+  // Terminal status and legal actions depend only on the betting history.
+  if (states[0].is_terminal()) {
+    for (size_t d = 0; d < n; ++d) {
+      values[d] = static_cast<double>(states[d].payoffs()[player]);
+    }
+    return values;
+  }
+  ActionType actions[kMaxInfoSetActions];
+  const int count = LegalActionList(states[0], actions);
+  const bool responding = states[0].current_player() == player;
+  std::vector<uint64_t> keys(n);
+  for (size_t d = 0; d < n; ++d) {
+    keys[d] = InfoSetKey(states[d]);
+  }
+
+  std::vector<double> child_values[kMaxInfoSetActions];
+  std::vector<GameState> children;
+  std::vector<double> child_weights;
+  for (int a = 0; a < count; ++a) {
+    children = states;
+    child_weights = weights;
+    for (size_t d = 0; d < n; ++d) {
+      children[d].ApplyAction(actions[a]);
+      if (!responding) {
+        child_weights[d] *= AverageProbability(keys[d], count, a);
+      }
+    }
+    child_values[a] = BestResponse(player, children, child_weights);
+  }
+
+  if (!responding) {
+    for (size_t d = 0; d < n; ++d) {
+      for (int a = 0; a < count; ++a) {
+        values[d] +=
+            AverageProbability(keys[d], count, a) * child_values[a][d];
+      }
+    }
+    return values;
+  }
+  // Deals sharing an information set must take the same action.
+  std::unordered_map<uint64_t, std::array<double, kMaxInfoSetActions>> gains;
+  for (size_t d = 0; d < n; ++d) {
+    auto& gain = gains.try_emplace(keys[d]).first->second;
+    for (int a = 0; a < count; ++a) {
+      gain[a] += weights[d] * child_values[a][d];
+    }
+  }
+  for (size_t d = 0; d < n; ++d) {
+    const auto& gain = gains[keys[d]];
+    const int best =
+        static_cast<int>(std::max_element(gain.begin(), gain.begin() + count) -
+                         gain.begin());
+    values[d] = child_values[best][d];
+  }
+  return values;
+}
+
+}  // namespace pokerbot::core
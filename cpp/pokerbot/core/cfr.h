@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "limit_holdem_game.h"
+#include "regret_table.h"
+
+namespace pokerbot::core {
+
+enum class CfrVariant : int {
+  kVanilla = 0,
+  // Regrets floored at zero after every update, linearly weighted averaging.
+  kCfrPlus = 1,
+  // Regrets and average strategy discounted by t / (t + 1).
+  kLinear = 2,
+  // Positive regrets by t^a / (t^a + 1), negative by t^b / (t^b + 1),
+  // average strategy by (t / (t + 1))^g.
+  kDiscounted = 3,
+};
+
+struct CfrOptions {
+  CfrVariant variant = CfrVariant::kDiscounted;
+  double alpha = 1.5;
+  double beta = 0.0;
+  double gamma = 2.0;
+  // Iterations between table-wide discounts for kLinear/kDiscounted; the
+  // discount exponent uses the number of completed intervals as t.
+  int64_t discount_interval = 1000;
+  // Leave discounting to the caller via ApplyDiscountsBetween; used when
+  // several trainers share one table and exactly one must discount it.
+  bool defer_discount = false;
+  // Update one player per traversal, alternating, instead of both at once.
+  bool alternating_updates = true;
+
+  // Regret-based pruning: at the updating player's nodes, skip actions the
+  // current strategy never plays whose regret is at or below the threshold;
+  // at the opponent's nodes, skip actions it never plays (they carry zero
+  // reach, so only the updating player's strategy sums below are lost).
+  bool regret_pruning = false;
+  // In chips, weighted by opponent reach. Well below zero so that only
+  // actions that have lost for many visits are skipped.
+  double prune_threshold = -300.0;
+  // No pruning before this many iterations.
+  int64_t prune_warmup_iterations = 1000;
+  // Every Nth iteration traverses the full tree so pruned regrets recover.
+  int64_t prune_recheck_interval = 20;
+
+  size_t table_capacity = size_t{1} << 20;
+  uint64_t seed = 0;
+};
+
+struct CfrStats {
+  int64_t iterations = 0;
+  size_t infosets = 0;
+  int64_t nodes_visited = 0;
+  int64_t actions_pruned = 0;
+};
+
+// Chance-sampled CFR over GameState. Each iteration deals one hand from the
+// seeded RNG and traverses the full betting tree for that deal. Information
+// sets are abstracted to (player, street, hand bucket, public betting
+// history): preflop buckets are the 169 canonical starting hands, postflop
+// buckets the made-hand category plus its top rank.
+class CfrTrainer {
+ public:
+  explicit CfrTrainer(GameConfig config = GameConfig(),
+                      CfrOptions options = CfrOptions());
+  // Trains into a caller-owned table (e.g. one in shared memory).
+  CfrTrainer(GameConfig config, CfrOptions options, RegretTable* table);
+
+  void RunIterations(int64_t iterations);
+
+  // Restricts chance to `deals` (full decks), sampled uniformly, instead of
+  // shuffling a fresh deck each iteration. An empty list restores shuffling.
+  // Together with Exploitability() this makes small test games.
+  void SetDeals(std::vector<std::array<uint8_t, kDeckSize>> deals);
+
+  // Sum over both players of the best-response gain against the average
+  // strategy (NashConv), in chips per hand, in the game whose chance
+  // outcomes are exactly `deals`, uniformly weighted. The best responder
+  // sees only the abstracted information sets. Traverses the betting tree
+  // once per player with every deal, so keep `deals` small. Throws
+  // std::invalid_argument when `deals` is empty.
+  double Exploitability(
+      const std::vector<std::array<uint8_t, kDeckSize>>& deals) const;
+
+  // Applies the table-wide discount for every interval boundary in
+  // (from_iteration, to_iteration]. No-op for kVanilla and kCfrPlus.
+  void ApplyDiscountsBetween(int64_t from_iteration, int64_t to_iteration);
+
+  // Continues the iteration count from another trainer sharing the table.
+  void set_iteration(int64_t iteration) { iteration_ = iteration; }
+  int64_t iteration() const { return iteration_; }
+  CfrStats stats() const;
+  const CfrOptions& options() const { return options_; }
+  RegretTable& table() { return *table_; }
+  const RegretTable& table() const { return *table_; }
+
+  // Abstracted information-set key for the player to act.
+  uint64_t InfoSetKey(const GameState& state) const;
+
+  // Average strategy for the player to act, indexed like LegalActions().
+  // Uniform when the information set has not been visited.
+  std::vector<double> AverageStrategy(const GameState& state) const;
+
+  // For every opponent holding (indexed by ComboIndex), the probability the
+  // average strategy takes `action` at `state` if the player to act held
+  // it. Holdings that clash with the exposed board get zero. Feeds
+  // OpponentRange::Update. Throws std::invalid_argument if `action` is not
+  // legal.
+  void ActionLikelihoods(const GameState& state, ActionType action,
+                         float* out) const;
+
+ private:
+  double Traverse(int depth, int update_player,
+                  const std::array<double, kNumPlayers>& reach);
+  // Best-response values for `player` in each of `states`, which share one
+  // betting history; `weights` are the chance-times-opponent reaches.
+  std::vector<double> BestResponse(int player,
+                                   const std::vector<GameState>& states,
+                                   const std::vector<double>& weights) const;
+  void ApplyDiscount(int64_t iteration);
+  bool PruningActive() const;
+  // Probability of legal action `index` (of `count`) in the stored average
+  // strategy for `key`; uniform when unvisited.
+  double AverageProbability(uint64_t key, int count, int index) const;
+
+  GameConfig config_;
+  CfrOptions options_;
+  std::unique_ptr<RegretTable> owned_table_;
+  RegretTable* table_ = nullptr;
+  std::mt19937_64 rng_;
+  std::vector<std::array<uint8_t, kDeckSize>> deals_;
+  // One state per tree depth so children reuse their history capacity.
+  std::vector<GameState> stack_;
+  int64_t iteration_ = 0;
+  int64_t nodes_visited_ = 0;
+  int64_t actions_pruned_ = 0;
+};
+
+}  // namespace pokerbot::core
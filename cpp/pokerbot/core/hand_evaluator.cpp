@@ -21,6 +21,113 @@ uint64_t EncodeValue(int category, const std::vector<int>& ranks) {
   return value;
 }
 
+uint64_t EncodeRanks(int category, const int* ranks, int count) {
+  uint64_t value = static_cast<uint64_t>(category) << kCategoryShift;
+  for (int i = 0; i < count && i < 5; ++i) {
+    value |= static_cast<uint64_t>(ranks[i] & 0xF) << (kRankShiftStep * (4 - i));
+  }
+  return value;
+}
+
+// Collects up to `limit` ranks from `mask`, highest first, skipping `skip`.
+int TopRanks(uint16_t mask, uint16_t skip, int limit, int* out) {
+  int count = 0;
+  for (int rank = kRanks - 1; rank >= 0 && count < limit; --rank) {
+    if ((mask & (1 << rank)) != 0 && (skip & (1 << rank)) == 0) {
+      out[count++] = rank;
+    }
+  }
+  return count;
+}
+
+int HighestStraightRank(uint16_t rank_mask);
+
+// Best-hand value straight from rank/suit counts of up to seven cards.
+uint64_t EvaluateCounts(const std::array<uint8_t, kRanks>& rank_counts,
+                        const std::array<uint8_t, kSuits>& suit_counts,
+                        const std::array<uint16_t, kSuits>& suit_masks) {
+  uint16_t rank_mask = 0;
+  uint16_t pair_mask = 0;
+  uint16_t trips_mask = 0;
+  int quads = -1;
+  for (int rank = 0; rank < kRanks; ++rank) {
+    const int count = rank_counts[rank];
+    if (count >= 1) {
+      rank_mask |= 1 << rank;
+    }
+    if (count >= 2) {
+      pair_mask |= 1 << rank;
+    }
+    if (count >= 3) {
+      trips_mask |= 1 << rank;
+    }
+    if (count == 4) {
+      quads = rank;
+    }
+  }
+
+  int ranks[5] = {};
+  int flush_suit = -1;
+  for (int suit = 0; suit < kSuits; ++suit) {
+    if (suit_counts[suit] >= 5) {
+      flush_suit = suit;
+      break;
+    }
+  }
+  if (flush_suit != -1) {
+    const int straight_flush = HighestStraightRank(suit_masks[flush_suit]);
+    if (straight_flush != -1) {
+      return EncodeRanks(8, &straight_flush, 1);
+    }
+  }
+
+  if (quads != -1) {
+    ranks[0] = quads;
+    const int kickers = TopRanks(rank_mask, 1 << quads, 1, ranks + 1);
+    if (kickers == 0) {
+      ranks[1] = 0;
+    }
+    return EncodeRanks(7, ranks, 2);
+  }
+
+  if (trips_mask != 0) {
+    TopRanks(trips_mask, 0, 1, ranks);
+    if (TopRanks(pair_mask, 1 << ranks[0], 1, ranks + 1) == 1) {
+      return EncodeRanks(6, ranks, 2);
+    }
+  }
+
+  if (flush_suit != -1) {
+    TopRanks(suit_masks[flush_suit], 0, 5, ranks);
+    return EncodeRanks(5, ranks, 5);
+  }
+
+  const int straight = HighestStraightRank(rank_mask);
+  if (straight != -1) {
+    return EncodeRanks(4, &straight, 1);
+  }
+
+  if (trips_mask != 0) {
+    TopRanks(trips_mask, 0, 1, ranks);
+    const int kickers = TopRanks(rank_mask, 1 << ranks[0], 2, ranks + 1);
+    return EncodeRanks(3, ranks, 1 + kickers);
+  }
+
+  const int pairs = TopRanks(pair_mask, 0, 2, ranks);
+  if (pairs == 2) {
+    const uint16_t used = static_cast<uint16_t>((1 << ranks[0]) | (1 << ranks[1]));
+    const int kickers = TopRanks(rank_mask, used, 1, ranks + 2);
+    return EncodeRanks(2, ranks, 2 + kickers);
+  }
+  if (pairs == 1) {
+    const int kickers = TopRanks(rank_mask, 1 << ranks[0], 3, ranks + 1);
+    return EncodeRanks(1, ranks, 1 + kickers);
+  }
+
+  const int high_cards = TopRanks(rank_mask, 0, 5, ranks);
+  return EncodeRanks(0, ranks, high_cards);
+}
+
 int HighestStraightRank(uint16_t rank_mask) {
   for (int high = 12; high >= 4; --high) {
     bool straight = true;
@@ -221,4 +328,34 @@ int CompareHands(const std::vector<uint8_t>& first,
   return 0;
 }
 
+void BoardEvaluator::Reset() {
+  rank_counts_.fill(0);
+  suit_counts_.fill(0);
+  suit_masks_.fill(0);
+  card_count_ = 0;
+}
+
+void BoardEvaluator::AddCard(uint8_t card) {
+  if (!IsValidCard(card) || card_count_ >= 5) {
+    throw std::invalid_argument("BoardEvaluator::AddCard got an invalid card");
+  }
+  ++rank_counts_[Rank(card)];
+  ++suit_counts_[Suit(card)];
+  suit_masks_[Suit(card)] |= static_cast<uint16_t>(1 << Rank(card));
+  ++card_count_;
+}
+
+uint64_t BoardEvaluator::Evaluate(
+    const std::array<uint8_t, 2>& hole_cards) const {
+  std::array<uint8_t, kRanks> rank_counts = rank_counts_;
+  std::array<uint8_t, kSuits> suit_counts = suit_counts_;
+  std::array<uint16_t, kSuits> suit_masks = suit_masks_;
+  for (uint8_t card : hole_cards) {
+    ++rank_counts[Rank(card)];
+    ++suit_counts[Suit(card)];
+    suit_masks[Suit(card)] |= static_cast<uint16_t>(1 << Rank(card));
+  }
+  return EvaluateCounts(rank_counts, suit_counts, suit_masks);
+}
+
 }  // namespace pokerbot::core
@@ -22,4 +22,23 @@ uint64_t EvaluateBestHand(const std::vector<uint8_t>& cards);
 int CompareHands(const std::vector<uint8_t>& first,
                  const std::vector<uint8_t>& second);
 
+// Keeps rank/suit counts and rank masks for the exposed board so a player's
+// strength is a two-card delta instead of a fresh 21-combination search.
+// Evaluate() matches EvaluateBestHand() for 5 to 7 total cards; with fewer
+// cards it scores the available pairs and high cards only.
+class BoardEvaluator {
+ public:
+  void Reset();
+  void AddCard(uint8_t card);
+  int card_count() const { return card_count_; }
+
+  uint64_t Evaluate(const std::array<uint8_t, 2>& hole_cards) const;
+
+ private:
+  std::array<uint8_t, kRanks> rank_counts_{};
+  std::array<uint8_t, kSuits> suit_counts_{};
+  std::array<uint16_t, kSuits> suit_masks_{};
+  int card_count_ = 0;
+};
+
 }  // namespace pokerbot::core
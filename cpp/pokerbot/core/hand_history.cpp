@@ -0,0 +1,566 @@
+#include "hand_history.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace pokerbot::core {
+namespace {
+
+constexpr uint8_t kFlagFullDeck = 0x1;
+constexpr int kTerminalReasonShift = 1;
+constexpr uint8_t kTerminalReasonMask = 0x3;
+
+std::array<uint32_t, 256> BuildCrcTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t c = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+void PutU16(uint8_t* out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void PutU32(uint8_t* out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint16_t GetU16(const uint8_t* in) {
+  return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t GetU32(const uint8_t* in) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+void PutVarint(uint64_t value, std::vector<uint8_t>* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t GetVarint(const uint8_t*& cursor, const uint8_t* end) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (cursor >= end) {
+      throw std::runtime_error("Hand history record is truncated");
+    }
+    const uint8_t byte = *cursor++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Hand history varint is malformed");
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void EncodeRecord(const HandRecord& record, bool store_full_deck,
+                  std::vector<uint8_t>* out) {
+  const bool full_deck = store_full_deck || record.full_deck;
+  PutVarint(record.hand_id, out);
+  uint8_t flags = full_deck ? kFlagFullDeck : 0;
+  flags |= static_cast<uint8_t>(
+      (static_cast<int>(record.terminal_reason) & kTerminalReasonMask)
+      << kTerminalReasonShift);
+  out->push_back(flags);
+  const int card_count = full_deck ? kDeckSize : kDealtCards;
+  out->insert(out->end(), record.deck.begin(),
+              record.deck.begin() + card_count);
+  PutVarint(record.actions.size(), out);
+  for (const ActionLogEntry& entry : record.actions) {
+    const uint64_t packed = (static_cast<uint64_t>(entry.betting_round) << 4) |
+                            (static_cast<uint64_t>(entry.player) << 3) |
+                            static_cast<uint64_t>(entry.action);
+    PutVarint(packed, out);
+  }
+  for (int player = 0; player < kNumPlayers; ++player) {
+    PutVarint(ZigZagEncode(record.payoffs[player]), out);
+  }
+}
+
+void DecodeRecord(const uint8_t*& cursor, const uint8_t* end,
+                  HandRecord* out) {
+  out->hand_id = GetVarint(cursor, end);
+  if (cursor >= end) {
+    throw std::runtime_error("Hand history record is truncated");
+  }
+  const uint8_t flags = *cursor++;
+  out->full_deck = (flags & kFlagFullDeck) != 0;
+  out->terminal_reason = static_cast<TerminalReason>(
+      (flags >> kTerminalReasonShift) & kTerminalReasonMask);
+
+  const int card_count = out->full_deck ? kDeckSize : kDealtCards;
+  if (end - cursor < card_count) {
+    throw std::runtime_error("Hand history record is truncated");
+  }
+  uint64_t used = 0;
+  for (int i = 0; i < card_count; ++i) {
+    const uint8_t card = cursor[i];
+    if (!IsValidCard(card) || (used & (uint64_t{1} << card)) != 0) {
+      throw std::runtime_error("Hand history record has an invalid deck");
+    }
+    used |= uint64_t{1} << card;
+    out->deck[i] = card;
+  }
+  cursor += card_count;
+  int next = card_count;
+  for (int card = 0; next < kDeckSize && card < kDeckSize; ++card) {
+    if ((used & (uint64_t{1} << card)) == 0) {
+      out->deck[next++] = static_cast<uint8_t>(card);
+    }
+  }
+
+  const uint64_t action_count = GetVarint(cursor, end);
+  if (action_count > static_cast<uint64_t>(end - cursor)) {
+    throw std::runtime_error("Hand history record is truncated");
+  }
+  out->actions.resize(action_count);
+  for (ActionLogEntry& entry : out->actions) {
+    const uint64_t packed = GetVarint(cursor, end);
+    const int action = static_cast<int>(packed & 0x7);
+    if (action > static_cast<int>(ActionType::kRaise)) {
+      throw std::runtime_error("Hand history record has an invalid action");
+    }
+    entry.action = static_cast<ActionType>(action);
+    entry.player = static_cast<int>((packed >> 3) & 0x1);
+    entry.betting_round = static_cast<int>(packed >> 4);
+  }
+  for (int player = 0; player < kNumPlayers; ++player) {
+    out->payoffs[player] = ZigZagDecode(GetVarint(cursor, end));
+  }
+}
+
+}  // namespace
+
+uint32_t HandHistoryChecksum(const uint8_t* data, size_t size) {
+  static const std::array<uint32_t, 256> kTable = BuildCrcTable();
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; ++i) {
+    crc = kTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+HandRecord HandRecord::FromState(const GameState& state, uint64_t hand_id) {
+  HandRecord record;
+  record.hand_id = hand_id;
+  record.deck = state.deck();
+  record.terminal_reason = state.terminal_reason();
+  record.actions = state.action_history();
+  record.payoffs = state.payoffs();
+  return record;
+}
+
+// --------------------------------------------------------------------------
+// Writer
+// --------------------------------------------------------------------------
+
+HandHistoryWriter::HandHistoryWriter(const std::string& path,
+                                     const GameConfig& config,
+                                     HandHistoryWriterOptions options)
+    : options_(options) {
+  if (options_.block_bytes == 0 || options_.max_pending_blocks == 0) {
+    throw std::invalid_argument("HandHistoryWriter options must be positive");
+  }
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    throw std::runtime_error("Failed to open hand history file: " + path);
+  }
+
+  std::array<uint8_t, kHandHistoryFileHeaderSize> header{};
+  PutU32(&header[0], kHandHistoryMagic);
+  PutU16(&header[4], kHandHistoryVersion);
+  PutU16(&header[6], static_cast<uint16_t>(kHandHistoryFileHeaderSize));
+  PutU32(&header[8], static_cast<uint32_t>(config.small_blind));
+  PutU32(&header[12], static_cast<uint32_t>(config.big_blind));
+  PutU32(&header[16], static_cast<uint32_t>(config.small_bet));
+  PutU32(&header[20], static_cast<uint32_t>(config.big_bet));
+  PutU32(&header[24], static_cast<uint32_t>(config.max_raises_per_round));
+  if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+    std::fclose(file_);
+    throw std::runtime_error("Failed to write hand history header: " + path);
+  }
+
+  current_.payload.reserve(options_.block_bytes + 128);
+  thread_ = std::thread(&HandHistoryWriter::WriterLoop, this);
+}
+
+HandHistoryWriter::~HandHistoryWriter() {
+  try {
+    Close();
+  } catch (...) {
+  }
+}
+
+void HandHistoryWriter::Append(const GameState& state, uint64_t hand_id) {
+  Append(HandRecord::FromState(state, hand_id));
+}
+
+void HandHistoryWriter::Append(const HandRecord& record) {
+  thread_local std::vector<uint8_t> scratch;
+  scratch.clear();
+  EncodeRecord(record, options_.store_full_deck, &scratch);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (closing_ || closed_) {
+    throw std::logic_error("HandHistoryWriter is closed");
+  }
+  current_.payload.insert(current_.payload.end(), scratch.begin(),
+                          scratch.end());
+  ++current_.record_count;
+  ++records_appended_;
+  if (current_.payload.size() < options_.block_bytes) {
+    return;
+  }
+  space_cv_.wait(lock, [this] {
+    return pending_.size() < options_.max_pending_blocks;
+  });
+  // Another appender may have sealed the block while we waited.
+  if (current_.payload.size() >= options_.block_bytes) {
+    SealCurrentBlockLocked();
+  }
+  lock.unlock();
+  work_cv_.notify_one();
+}
+
+void HandHistoryWriter::SealCurrentBlockLocked() {
+  if (current_.record_count == 0) {
+    return;
+  }
+  pending_.push_back(std::move(current_));
+  current_ = PendingBlock();
+  current_.payload.reserve(options_.block_bytes + 128);
+}
+
+void HandHistoryWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (closed_) {
+    return;
+  }
+  SealCurrentBlockLocked();
+  work_cv_.notify_one();
+  drained_cv_.wait(lock, [this] { return pending_.empty() && !writing_; });
+  if (std::fflush(file_) != 0) {
+    io_error_ = true;
+  }
+  if (io_error_) {
+    throw std::runtime_error("Failed to write hand history block");
+  }
+}
+
+void HandHistoryWriter::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || closing_) {
+      return;
+    }
+    SealCurrentBlockLocked();
+    closing_ = true;
+  }
+  work_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  const bool close_failed = std::fclose(file_) != 0;
+  file_ = nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = true;
+  if (io_error_ || close_failed) {
+    throw std::runtime_error("Failed to write hand history block");
+  }
+}
+
+uint64_t HandHistoryWriter::records_appended() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return records_appended_;
+}
+
+void HandHistoryWriter::WriterLoop() {
+  for (;;) {
+    PendingBlock block;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] { return !pending_.empty() || closing_; });
+      if (pending_.empty()) {
+        return;
+      }
+      block = std::move(pending_.front());
+      pending_.pop_front();
+      writing_ = true;
+    }
+    space_cv_.notify_all();
+
+    std::array<uint8_t, kHandHistoryBlockHeaderSize> header{};
+    PutU32(&header[0], kHandHistoryBlockMagic);
+    PutU32(&header[4], block.record_count);
+    PutU32(&header[8], static_cast<uint32_t>(block.payload.size()));
+    PutU32(&header[12], HandHistoryChecksum(block.payload.data(),
+                                            block.payload.size()));
+    const bool ok =
+        std::fwrite(header.data(), 1, header.size(), file_) == header.size() &&
+        std::fwrite(block.payload.data(), 1, block.payload.size(), file_) ==
+            block.payload.size();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      writing_ = false;
+      if (!ok) {
+        io_error_ = true;
+      }
+    }
+    drained_cv_.notify_all();
+  }
+}
+
+// --------------------------------------------------------------------------
+// Reader
+// --------------------------------------------------------------------------
+
+HandHistoryReader::HandHistoryReader(const std::string& path,
+                                     bool verify_checksums)
+    : verify_checksums_(verify_checksums) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open hand history file: " + path);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < kHandHistoryFileHeaderSize) {
+    ::close(fd);
+    throw std::runtime_error("Hand history file is too small: " + path);
+  }
+  size_bytes_ = static_cast<size_t>(info.st_size);
+  void* mapping = ::mmap(nullptr, size_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Failed to map hand history file: " + path);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  try {
+    if (GetU32(data_) != kHandHistoryMagic) {
+      throw std::runtime_error("Not a hand history file: " + path);
+    }
+    if (GetU16(data_ + 4) != kHandHistoryVersion) {
+      throw std::runtime_error("Unsupported hand history version: " + path);
+    }
+    const size_t header_size = GetU16(data_ + 6);
+    if (header_size < kHandHistoryFileHeaderSize || header_size > size_bytes_) {
+      throw std::runtime_error("Corrupt hand history header: " + path);
+    }
+    config_.small_blind = static_cast<int32_t>(GetU32(data_ + 8));
+    config_.big_blind = static_cast<int32_t>(GetU32(data_ + 12));
+    config_.small_bet = static_cast<int32_t>(GetU32(data_ + 16));
+    config_.big_bet = static_cast<int32_t>(GetU32(data_ + 20));
+    config_.max_raises_per_round = static_cast<int32_t>(GetU32(data_ + 24));
+
+    size_t offset = header_size;
+    while (size_bytes_ - offset >= kHandHistoryBlockHeaderSize) {
+      const uint8_t* header = data_ + offset;
+      if (GetU32(header) != kHandHistoryBlockMagic) {
+        throw std::runtime_error("Corrupt hand history block header: " + path);
+      }
+      BlockInfo block;
+      block.record_count = GetU32(header + 4);
+      block.payload_bytes = GetU32(header + 8);
+      block.checksum = GetU32(header + 12);
+      block.payload_offset = offset + kHandHistoryBlockHeaderSize;
+      if (size_bytes_ - block.payload_offset < block.payload_bytes) {
+        break;  // Truncated tail.
+      }
+      block.first_index = total_records_;
+      total_records_ += block.record_count;
+      blocks_.push_back(block);
+      offset = block.payload_offset + block.payload_bytes;
+    }
+  } catch (...) {
+    ::munmap(const_cast<uint8_t*>(data_), size_bytes_);
+    throw;
+  }
+
+  verified_.reset(new std::atomic<bool>[blocks_.size()]);
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    verified_[i].store(!verify_checksums_, std::memory_order_relaxed);
+  }
+}
+
+HandHistoryReader::~HandHistoryReader() {
+  if (data_) {
+    ::munmap(const_cast<uint8_t*>(data_), size_bytes_);
+  }
+}
+
+size_t HandHistoryReader::block_first_index(size_t block) const {
+  if (block >= blocks_.size()) {
+    throw std::out_of_range("Invalid hand history block");
+  }
+  return blocks_[block].first_index;
+}
+
+size_t HandHistoryReader::block_record_count(size_t block) const {
+  if (block >= blocks_.size()) {
+    throw std::out_of_range("Invalid hand history block");
+  }
+  return blocks_[block].record_count;
+}
+
+size_t HandHistoryReader::BlockForIndex(size_t index) const {
+  if (index >= total_records_) {
+    throw std::out_of_range("Invalid hand history record index");
+  }
+  const auto it = std::upper_bound(
+      blocks_.begin(), blocks_.end(), index,
+      [](size_t value, const BlockInfo& block) {
+        return value < block.first_index;
+      });
+  return static_cast<size_t>(it - blocks_.begin()) - 1;
+}
+
+void HandHistoryReader::VerifyBlock(size_t block) const {
+  if (verified_[block].load(std::memory_order_acquire)) {
+    return;
+  }
+  const BlockInfo& info = blocks_[block];
+  if (HandHistoryChecksum(data_ + info.payload_offset, info.payload_bytes) !=
+      info.checksum) {
+    throw std::runtime_error("Hand history block checksum mismatch");
+  }
+  verified_[block].store(true, std::memory_order_release);
+}
+
+HandRecord HandHistoryReader::Read(size_t index) const {
+  HandRecord record;
+  ReadInto(index, &record);
+  return record;
+}
+
+void HandHistoryReader::ReadInto(size_t index, HandRecord* out) const {
+  const size_t block = BlockForIndex(index);
+  VerifyBlock(block);
+  const BlockInfo& info = blocks_[block];
+  const uint8_t* cursor = data_ + info.payload_offset;
+  const uint8_t* end = cursor + info.payload_bytes;
+  for (size_t i = info.first_index; i <= index; ++i) {
+    DecodeRecord(cursor, end, out);
+  }
+}
+
+bool HandHistoryReader::DecodeBlock(
+    size_t block,
+    const std::function<bool(size_t, const HandRecord&)>& visitor) const {
+  if (block >= blocks_.size()) {
+    throw std::out_of_range("Invalid hand history block");
+  }
+  VerifyBlock(block);
+  const BlockInfo& info = blocks_[block];
+  const uint8_t* cursor = data_ + info.payload_offset;
+  const uint8_t* end = cursor + info.payload_bytes;
+  HandRecord record;
+  for (uint32_t i = 0; i < info.record_count; ++i) {
+    DecodeRecord(cursor, end, &record);
+    if (!visitor(info.first_index + i, record)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t HandHistoryReader::ForEach(
+    const std::function<bool(const HandRecord&)>& visitor) const {
+  return ForEach([](const HandRecord&) { return true; }, visitor);
+}
+
+size_t HandHistoryReader::ForEach(
+    const std::function<bool(const HandRecord&)>& predicate,
+    const std::function<bool(const HandRecord&)>& visitor) const {
+  size_t visited = 0;
+  for (size_t block = 0; block < blocks_.size(); ++block) {
+    const bool keep_going =
+        DecodeBlock(block, [&](size_t, const HandRecord& record) {
+          if (!predicate(record)) {
+            return true;
+          }
+          ++visited;
+          return visitor(record);
+        });
+    if (!keep_going) {
+      break;
+    }
+  }
+  return visited;
+}
+
+// --------------------------------------------------------------------------
+// Cursor
+// --------------------------------------------------------------------------
+
+HandHistoryCursor::HandHistoryCursor(const HandHistoryReader& reader,
+                                     size_t start)
+    : reader_(reader), index_(start) {
+  if (start > reader_.size()) {
+    throw std::out_of_range("Invalid hand history record index");
+  }
+  if (start == reader_.size()) {
+    block_ = reader_.blocks_.size();
+    return;
+  }
+  EnterBlock(reader_.BlockForIndex(start));
+  HandRecord skipped;
+  for (size_t i = reader_.blocks_[block_].first_index; i < start; ++i) {
+    DecodeRecord(cursor_, end_, &skipped);
+    --remaining_;
+  }
+}
+
+void HandHistoryCursor::EnterBlock(size_t block) {
+  reader_.VerifyBlock(block);
+  const HandHistoryReader::BlockInfo& info = reader_.blocks_[block];
+  block_ = block;
+  remaining_ = info.record_count;
+  cursor_ = reader_.data_ + info.payload_offset;
+  end_ = cursor_ + info.payload_bytes;
+}
+
+bool HandHistoryCursor::Next(HandRecord* out) {
+  while (remaining_ == 0) {
+    if (block_ + 1 >= reader_.blocks_.size()) {
+      return false;
+    }
+    EnterBlock(block_ + 1);
+  }
+  DecodeRecord(cursor_, end_, out);
+  --remaining_;
+  ++index_;
+  return true;
+}
+
+}  // namespace pokerbot::core
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cards.h"
+#include "limit_holdem_game.h"
+
+namespace pokerbot::core {
+
+// On-disk layout (all integers little-endian):
+//
+//   FileHeader (32 bytes, written once)
+//   Block*     (appended by the writer, never rewritten)
+//
+// Each block is a 16-byte BlockHeader followed by `payload_bytes` of records.
+// A record is
+//   varint hand_id
+//   uint8  flags            bit0: full 52-card deck, bits1-2: terminal reason
+//   uint8  cards[9 or 52]   dealt cards in deal order, or the full deck
+//   varint action_count
+//   varint action[action_count]  (round << 4) | (player << 3) | action
+//   varint zigzag(payoff[0]), zigzag(payoff[1])
+// The block checksum is a CRC-32 over the payload.
+constexpr uint32_t kHandHistoryMagic = 0x48484250;  // "PBHH"
+constexpr uint32_t kHandHistoryBlockMagic = 0x42484250;  // "PBHB"
+constexpr uint16_t kHandHistoryVersion = 1;
+constexpr size_t kHandHistoryFileHeaderSize = 32;
+constexpr size_t kHandHistoryBlockHeaderSize = 16;
+// Hole cards for both players plus the five board cards.
+constexpr int kDealtCards = 9;
+
+struct HandRecord {
+  uint64_t hand_id = 0;
+  // Always a full 52-card deck when decoded; undealt cards are filled in
+  // ascending order when only the dealt cards were stored.
+  std::array<uint8_t, kDeckSize> deck{};
+  bool full_deck = false;
+  TerminalReason terminal_reason = TerminalReason::kNone;
+  std::vector<ActionLogEntry> actions;
+  std::array<int64_t, kNumPlayers> payoffs{};
+
+  // Captures a (normally terminal) hand from the engine.
+  static HandRecord FromState(const GameState& state, uint64_t hand_id);
+};
+
+struct HandHistoryWriterOptions {
+  // Records are buffered until a block reaches this many payload bytes.
+  size_t block_bytes = 1 << 16;
+  // Appenders block once this many sealed blocks await the writer thread.
+  size_t max_pending_blocks = 64;
+  // Stores the full deck instead of only the nine dealt cards.
+  bool store_full_deck = false;
+};
+
+// Append-only writer. Append() is safe to call from many threads; encoding
+// happens on the calling thread and file I/O on a background thread.
+class HandHistoryWriter {
+ public:
+  HandHistoryWriter(const std::string& path, const GameConfig& config,
+                    HandHistoryWriterOptions options = HandHistoryWriterOptions());
+  ~HandHistoryWriter();
+
+  HandHistoryWriter(const HandHistoryWriter&) = delete;
+  HandHistoryWriter& operator=(const HandHistoryWriter&) = delete;
+
+  void Append(const HandRecord& record);
+  void Append(const GameState& state, uint64_t hand_id);
+
+  // Seals the current block and waits until everything appended so far has
+  // reached the file. Throws std::runtime_error if any write failed.
+  void Flush();
+
+  // Flushes and stops the background thread. Further appends throw.
+  void Close();
+
+  uint64_t records_appended() const;
+
+ private:
+  struct PendingBlock {
+    uint32_t record_count = 0;
+    std::vector<uint8_t> payload;
+  };
+
+  void SealCurrentBlockLocked();
+  void WriterLoop();
+
+  HandHistoryWriterOptions options_;
+  std::FILE* file_ = nullptr;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable space_cv_;
+  std::condition_variable drained_cv_;
+  PendingBlock current_;
+  std::deque<PendingBlock> pending_;
+  bool writing_ = false;
+  bool closing_ = false;
+  bool closed_ = false;
+  bool io_error_ = false;
+  uint64_t records_appended_ = 0;
+
+  std::thread thread_;
+};
+
+// Random-access reader over an mmap'ed history file. A truncated trailing
+// block (e.g. from a crashed writer) is ignored.
+class HandHistoryReader {
+ public:
+  explicit HandHistoryReader(const std::string& path,
+                             bool verify_checksums = true);
+  ~HandHistoryReader();
+
+  HandHistoryReader(const HandHistoryReader&) = delete;
+  HandHistoryReader& operator=(const HandHistoryReader&) = delete;
+
+  const GameConfig& config() const { return config_; }
+  size_t size() const { return total_records_; }
+  size_t block_count() const { return blocks_.size(); }
+  size_t block_first_index(size_t block) const;
+  size_t block_record_count(size_t block) const;
+
+  // Decodes a single record. Throws std::out_of_range for a bad index.
+  HandRecord Read(size_t index) const;
+  void ReadInto(size_t index, HandRecord* out) const;
+
+  // Decodes every record of `block` in order. The visitor receives the global
+  // record index and returns false to stop early. Returns false if stopped.
+  bool DecodeBlock(
+      size_t block,
+      const std::function<bool(size_t, const HandRecord&)>& visitor) const;
+
+  // Visits all records in file order; returns the number visited.
+  size_t ForEach(const std::function<bool(const HandRecord&)>& visitor) const;
+
+  // Visits the records accepted by `predicate`; returns the number visited.
+  size_t ForEach(const std::function<bool(const HandRecord&)>& predicate,
+                 const std::function<bool(const HandRecord&)>& visitor) const;
+
+ private:
+  friend class HandHistoryCursor;
+
+  struct BlockInfo {
+    size_t payload_offset = 0;
+    uint32_t payload_bytes = 0;
+    uint32_t record_count = 0;
+    uint32_t checksum = 0;
+    size_t first_index = 0;
+  };
+
+  size_t BlockForIndex(size_t index) const;
+  void VerifyBlock(size_t block) const;
+
+  const uint8_t* data_ = nullptr;
+  size_t size_bytes_ = 0;
+  bool verify_checksums_ = true;
+  GameConfig config_;
+  std::vector<BlockInfo> blocks_;
+  std::unique_ptr<std::atomic<bool>[]> verified_;
+  size_t total_records_ = 0;
+};
+
+// Sequential reader for pull-style iteration. Each block is decoded once,
+// whereas Read() re-decodes a block from its start for every record. The
+// reader must outlive the cursor.
+class HandHistoryCursor {
+ public:
+  // Positions the cursor before record `start` (at most reader.size()).
+  explicit HandHistoryCursor(const HandHistoryReader& reader,
+                             size_t start = 0);
+
+  // Decodes the next record into `out`; false once the file is exhausted.
+  bool Next(HandRecord* out);
+
+  // Index of the record the next call to Next() returns.
+  size_t index() const { return index_; }
+
+ private:
+  void EnterBlock(size_t block);
+
+  const HandHistoryReader& reader_;
+  size_t block_ = 0;
+  size_t index_ = 0;
+  uint32_t remaining_ = 0;
+  const uint8_t* cursor_ = nullptr;
+  const uint8_t* end_ = nullptr;
+};
+
+// Exposed for tools that need to validate blocks independently.
+uint32_t HandHistoryChecksum(const uint8_t* data, size_t size);
+
+}  // namespace pokerbot::core
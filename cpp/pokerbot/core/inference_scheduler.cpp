@@ -0,0 +1,299 @@
+#include "inference_scheduler.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace pokerbot::core {
+namespace {
+
+// Parked hands resumed per pool task.
+constexpr size_t kResumeChunk = 64;
+
+constexpr int kBoardOffset = kDeckSize;
+constexpr int kRoundOffset = 2 * kDeckSize;
+constexpr int kScalarOffset = kRoundOffset + 4;
+
+static_assert(kScalarOffset + 4 == kObservationSize,
+              "Observation layout and size disagree");
+
+// Uniform double in [0, 1) from the top 53 bits.
+double UnitDraw(std::mt19937_64& rng) {
+  return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+ActionType SampleAction(uint32_t legal, const float* probabilities,
+                        std::mt19937_64& rng) {
+  double weights[kNumActionTypes] = {};
+  double total = 0.0;
+  int legal_count = 0;
+  for (int a = 0; a < kNumActionTypes; ++a) {
+    if ((legal & (1u << a)) == 0) {
+      continue;
+    }
+    ++legal_count;
+    // Written so NaN counts as zero.
+    weights[a] = probabilities[a] > 0.0f ? probabilities[a] : 0.0;
+    total += weights[a];
+  }
+  if (!(total > 0.0)) {
+    for (int a = 0; a < kNumActionTypes; ++a) {
+      weights[a] = (legal & (1u << a)) != 0 ? 1.0 : 0.0;
+    }
+    total = legal_count;
+  }
+  double draw = UnitDraw(rng) * total;
+  int last_legal = 0;
+  for (int a = 0; a < kNumActionTypes; ++a) {
+    if (weights[a] <= 0.0) {
+      continue;
+    }
+    last_legal = a;
+    if (draw < weights[a]) {
+      return static_cast<ActionType>(a);
+    }
+    draw -= weights[a];
+  }
+  return static_cast<ActionType>(last_legal);
+}
+
+}  // namespace
+
+void EncodeObservation(const GameState& state, float* out) {
+  std::fill(out, out + kObservationSize, 0.0f);
+  const int player = state.current_player();
+  if (player < 0 || player >= kNumPlayers) {
+    return;
+  }
+  for (uint8_t card : state.hole_cards(player)) {
+    out[card] = 1.0f;
+  }
+  for (uint8_t card : state.board_cards()) {
+    out[kBoardOffset + card] = 1.0f;
+  }
+  const int round = state.betting_round();
+  if (round >= 0 && round < 4) {
+    out[kRoundOffset + round] = 1.0f;
+  }
+  const GameConfig& config = state.config();
+  const float big_bet = static_cast<float>(std::max(1, config.big_bet));
+  out[kScalarOffset] = static_cast<float>(player);
+  out[kScalarOffset + 1] = static_cast<float>(state.pot()) / big_bet;
+  out[kScalarOffset + 2] = static_cast<float>(state.ToCall(player)) / big_bet;
+  out[kScalarOffset + 3] =
+      static_cast<float>(state.raises_in_round()) /
+      static_cast<float>(std::max(1, config.max_raises_per_round));
+}
+
+InferenceScheduler::InferenceScheduler(GameConfig config,
+                                       InferenceSchedulerOptions options)
+    : config_(config), options_(options) {
+  if (options_.num_hands < 0 || options_.concurrent_hands <= 0 ||
+      options_.max_batch_size <= 0 || options_.max_wait_ms < 0.0) {
+    throw std::invalid_argument("Invalid InferenceSchedulerOptions");
+  }
+}
+
+bool InferenceScheduler::StartHand(int slot) {
+  const int64_t index = next_hand_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= options_.num_hands) {
+    return false;
+  }
+  Hand& hand = hands_[slot];
+  hand.index = index;
+  const uint64_t seed = ThreadPool::TaskSeed(options_.seed, index);
+  hand.state.Reset(seed);
+  // Sampling draws from its own stream so it never perturbs the deal.
+  hand.rng.seed(ThreadPool::TaskSeed(seed, 0));
+  Park(slot);
+  return true;
+}
+
+void InferenceScheduler::Park(int slot) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({slot, std::chrono::steady_clock::now()});
+  }
+  ready_.notify_one();
+}
+
+void InferenceScheduler::Resume(int slot, const float* probabilities) {
+  Hand& hand = hands_[slot];
+  const ActionType action =
+      SampleAction(hand.state.LegalActionMask(), probabilities, hand.rng);
+  if (!hand.state.ApplyAction(action)) {
+    throw std::logic_error("Sampled an illegal action");
+  }
+  if (!hand.state.is_terminal()) {
+    Park(slot);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_.push_back({hand.index, hand.state});
+  }
+  StartHand(slot);
+}
+
+InferenceSchedulerStats InferenceScheduler::Run(
+    const BatchPolicyFn& policy, const HandCompleteFn& on_complete) {
+  if (!policy) {
+    throw std::invalid_argument("InferenceScheduler requires a policy");
+  }
+  const int slot_count = static_cast<int>(std::min<int64_t>(
+      options_.concurrent_hands, std::max<int64_t>(options_.num_hands, 1)));
+  hands_.assign(slot_count, Hand(config_));
+  next_hand_.store(0);
+  pending_.clear();
+  finished_.clear();
+  in_flight_ = 0;
+  error_ = nullptr;
+
+  InferenceSchedulerStats stats;
+  for (int slot = 0; slot < slot_count; ++slot) {
+    StartHand(slot);
+  }
+
+  std::shared_ptr<ThreadPool> pool = DefaultThreadPool();
+  const auto max_wait = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::duration<double, std::milli>(options_.max_wait_ms));
+  const size_t batch_limit = static_cast<size_t>(options_.max_batch_size);
+  std::vector<int> slots;
+  std::vector<Finished> finished;
+  std::vector<float> observations;
+  std::vector<uint32_t> legal_masks;
+  std::vector<const GameState*> states;
+  std::vector<float> probabilities;
+  std::exception_ptr error;
+
+  for (;;) {
+    slots.clear();
+    finished.clear();
+    bool drained = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // Gather until the batch is full, the oldest hand times out, or no
+      // resumes are outstanding (so nothing else can arrive).
+      while (!error_ && !error && in_flight_ > 0 &&
+             pending_.size() < batch_limit) {
+        if (pending_.empty()) {
+          ready_.wait(lock);
+          continue;
+        }
+        const auto deadline = pending_.front().since + max_wait;
+        if (std::chrono::steady_clock::now() >= deadline) {
+          break;
+        }
+        ready_.wait_until(lock, deadline);
+      }
+      if (error_ && !error) {
+        error = error_;
+      }
+      if (error) {
+        // Stop dealing out batches and sleep until outstanding resumes
+        // finish; they still park hands and notify.
+        ready_.wait(lock, [this] { return in_flight_ == 0; });
+        pending_.clear();
+      }
+      finished.swap(finished_);
+      while (!pending_.empty() && slots.size() < batch_limit) {
+        slots.push_back(pending_.front().slot);
+        pending_.pop_front();
+      }
+      drained = slots.empty() && in_flight_ == 0;
+    }
+
+    if (!error) {
+      try {
+        for (const Finished& hand : finished) {
+          ++stats.hands;
+          const auto payoffs = hand.state.payoffs();
+          for (int player = 0; player < kNumPlayers; ++player) {
+            stats.payoff_sum[player] += payoffs[player];
+          }
+          if (on_complete) {
+            on_complete(hand.index, hand.state);
+          }
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    if (drained) {
+      break;
+    }
+    if (error || slots.empty()) {
+      // On error the next pass waits for in_flight_ to reach zero.
+      continue;
+    }
+
+    const size_t count = slots.size();
+    observations.resize(count * kObservationSize);
+    legal_masks.resize(count);
+    states.resize(count);
+    probabilities.assign(count * kNumActionTypes, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+      const GameState& state = hands_[slots[i]].state;
+      EncodeObservation(state, &observations[i * kObservationSize]);
+      legal_masks[i] = state.LegalActionMask();
+      states[i] = &state;
+    }
+    InferenceBatch batch;
+    batch.size = static_cast<int>(count);
+    batch.observations = observations.data();
+    batch.legal_masks = legal_masks.data();
+    batch.states = states.data();
+    try {
+      policy(batch, probabilities.data());
+    } catch (...) {
+      error = std::current_exception();
+      continue;
+    }
+    ++stats.batches;
+    stats.decisions += static_cast<int64_t>(count);
+    stats.largest_batch =
+        std::max<int64_t>(stats.largest_batch, static_cast<int64_t>(count));
+
+    for (size_t begin = 0; begin < count; begin += kResumeChunk) {
+      const size_t end = std::min(count, begin + kResumeChunk);
+      // The task owns its rows; the batch buffers are reused next round.
+      auto chunk_slots = std::make_shared<std::vector<int>>(
+          slots.begin() + begin, slots.begin() + end);
+      auto chunk_probabilities = std::make_shared<std::vector<float>>(
+          probabilities.begin() + begin * kNumActionTypes,
+          probabilities.begin() + end * kNumActionTypes);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++in_flight_;
+      }
+      pool->Submit([this, chunk_slots, chunk_probabilities] {
+        std::exception_ptr failure;
+        try {
+          for (size_t i = 0; i < chunk_slots->size(); ++i) {
+            Resume((*chunk_slots)[i],
+                   chunk_probabilities->data() + i * kNumActionTypes);
+          }
+        } catch (...) {
+          failure = std::current_exception();
+        }
+        // Notify under the lock: once in_flight_ reaches zero Run() may
+        // return and destroy the scheduler.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failure && !error_) {
+          error_ = failure;
+        }
+        --in_flight_;
+        ready_.notify_one();
+      });
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return stats;
+}
+
+}  // namespace pokerbot::core
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "limit_holdem_game.h"
+#include "thread_pool.h"
+
+namespace pokerbot::core {
+
+// Floats per encoded observation, from the acting player's perspective:
+// hole cards (52, one-hot), exposed board (52), betting round (4), then the
+// actor's seat, pot and amount to call in big bets, and raises so far as a
+// fraction of the cap.
+constexpr int kObservationSize = 112;
+
+void EncodeObservation(const GameState& state, float* out);
+
+struct InferenceSchedulerOptions {
+  // Hands to play in total; hand i is dealt with Reset(TaskSeed(seed, i)).
+  int64_t num_hands = 1000;
+  // Hands in flight at once.
+  int concurrent_hands = 1024;
+  int max_batch_size = 256;
+  // A partial batch is flushed once its oldest hand has waited this long.
+  double max_wait_ms = 1.0;
+  uint64_t seed = 0;
+};
+
+// Parked decisions handed to the policy in one call. Row i of
+// `observations` (kObservationSize floats) and `legal_masks` describe
+// states[i]; states stay untouched until the policy returns.
+struct InferenceBatch {
+  int size = 0;
+  const float* observations = nullptr;
+  const uint32_t* legal_masks = nullptr;
+  const GameState* const* states = nullptr;
+};
+
+// Writes kNumActionTypes probabilities per row, indexed by action code.
+// Illegal actions are ignored; rows without legal mass play uniformly.
+using BatchPolicyFn =
+    std::function<void(const InferenceBatch& batch, float* probabilities)>;
+using HandCompleteFn =
+    std::function<void(int64_t hand_index, const GameState& final_state)>;
+
+struct InferenceSchedulerStats {
+  int64_t hands = 0;
+  int64_t decisions = 0;
+  int64_t batches = 0;
+  int64_t largest_batch = 0;
+  std::array<int64_t, kNumPlayers> payoff_sum{};
+};
+
+// Plays many concurrent hands against a batched policy. Each hand is a
+// small state machine that parks at every decision; the thread calling
+// Run() gathers parked hands into batches (by size or by timeout), calls
+// the policy once per batch, and hands the sampled actions to the shared
+// thread pool, which resumes the hands while the next batch is gathered.
+// Policy and completion callbacks run on the calling thread only. Action
+// sampling uses a per-hand stream, so a deterministic policy reproduces
+// the same hands regardless of batching or thread count.
+class InferenceScheduler {
+ public:
+  explicit InferenceScheduler(GameConfig config = GameConfig(),
+                              InferenceSchedulerOptions options =
+                                  InferenceSchedulerOptions());
+
+  // Exceptions from the callbacks propagate after in-flight work drains.
+  InferenceSchedulerStats Run(const BatchPolicyFn& policy,
+                              const HandCompleteFn& on_complete = nullptr);
+
+ private:
+  struct Hand {
+    explicit Hand(const GameConfig& config) : state(config) {}
+
+    GameState state;
+    std::mt19937_64 rng;
+    int64_t index = -1;
+  };
+
+  struct Parked {
+    int slot;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  struct Finished {
+    int64_t index;
+    GameState state;
+  };
+
+  // Deals the slot's next hand and parks it; false when none are left.
+  bool StartHand(int slot);
+  void Park(int slot);
+  // Applies the sampled action and parks or finishes the hand.
+  void Resume(int slot, const float* probabilities);
+
+  GameConfig config_;
+  InferenceSchedulerOptions options_;
+  std::vector<Hand> hands_;
+  std::atomic<int64_t> next_hand_{0};
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<Parked> pending_;
+  std::vector<Finished> finished_;
+  int in_flight_ = 0;
+  std::exception_ptr error_;
+};
+
+}  // namespace pokerbot::core
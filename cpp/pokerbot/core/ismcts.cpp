@@ -0,0 +1,276 @@
+#include "ismcts.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "thread_pool.h"
+
+namespace pokerbot::core {
+namespace {
+
+constexpr int kMaxChildren = 3;
+constexpr size_t kArenaChunkNodes = 4096;
+constexpr int64_t kClockCheckInterval = 64;
+
+struct Node {
+  std::array<std::atomic<Node*>, kMaxChildren> children{};
+  std::atomic<int32_t> visits{0};
+  std::atomic<int32_t> virtual_loss{0};
+  // Sum of payoffs (big bets) for the player who chose the edge into here.
+  std::atomic<double> value_sum{0.0};
+  std::array<ActionType, kMaxChildren> actions{};
+  int num_actions = 0;
+  int player = -1;
+
+  void Init(const GameState& state) {
+    const auto legal = state.LegalActions();
+    num_actions = static_cast<int>(legal.size());
+    std::copy(legal.begin(), legal.end(), actions.begin());
+    player = state.current_player();
+  }
+};
+
+// Single-threaded bump allocator; each search thread owns one.
+class NodeArena {
+ public:
+  Node* Allocate() {
+    if (chunks_.empty() || used_ == kArenaChunkNodes) {
+      chunks_.push_back(std::make_unique<Node[]>(kArenaChunkNodes));
+      used_ = 0;
+    }
+    return &chunks_.back()[used_++];
+  }
+
+  // Returns the most recent allocation, which must not have been published.
+  void ReleaseLast() { --used_; }
+
+  size_t size() const {
+    return chunks_.empty() ? 0
+                           : (chunks_.size() - 1) * kArenaChunkNodes + used_;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Node[]>> chunks_;
+  size_t used_ = 0;
+};
+
+void AtomicAdd(std::atomic<double>* target, double delta) {
+  double current = target->load(std::memory_order_relaxed);
+  while (!target->compare_exchange_weak(current, current + delta,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+// Snapshot slots the searching player cannot see: the opponent's hole cards
+// and the board cards that have not been exposed yet.
+std::vector<int> HiddenSlots(int searcher, int board_count) {
+  const int opponent = 1 - searcher;
+  std::vector<int> slots{opponent, opponent + 2};
+  for (int i = 4 + board_count; i < 9; ++i) {
+    slots.push_back(i);
+  }
+  return slots;
+}
+
+}  // namespace
+
+IsmctsResult RunIsmcts(const GameState& state, const IsmctsOptions& options) {
+  if (state.is_terminal()) {
+    throw std::invalid_argument("RunIsmcts requires a non-terminal state");
+  }
+  if (options.max_iterations <= 0 && options.time_budget_ms <= 0.0) {
+    throw std::invalid_argument("RunIsmcts requires an iteration or time budget");
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const GameConfig config = state.config();
+  const double big_bet = std::max(1, config.big_bet);
+  const int searcher = state.current_player();
+  const GameSnapshot root_snapshot = state.Snapshot();
+  const std::vector<int> hidden_slots =
+      HiddenSlots(searcher, state.board_card_count());
+
+  std::vector<uint8_t> unseen;
+  {
+    uint64_t seen = 0;
+    for (int i = 0; i < 9; ++i) {
+      const bool hidden = std::find(hidden_slots.begin(), hidden_slots.end(),
+                                    i) != hidden_slots.end();
+      if (!hidden) {
+        seen |= uint64_t{1} << root_snapshot.cards[i];
+      }
+    }
+    for (int card = 0; card < kDeckSize; ++card) {
+      if ((seen & (uint64_t{1} << card)) == 0) {
+        unseen.push_back(static_cast<uint8_t>(card));
+      }
+    }
+  }
+
+  Node root;
+  root.Init(state);
+
+  std::shared_ptr<ThreadPool> pool = DefaultThreadPool();
+  const int num_threads =
+      options.num_threads > 0 ? options.num_threads : pool->num_threads();
+  std::vector<NodeArena> arenas(num_threads);
+  std::atomic<int64_t> claimed{0};
+  std::atomic<int64_t> completed{0};
+  std::atomic<bool> out_of_time{false};
+
+  auto worker = [&](size_t lane) {
+    NodeArena& arena = arenas[lane];
+    std::mt19937_64 rng(ThreadPool::TaskSeed(options.seed, lane));
+    GameState sim(config);
+    std::vector<uint8_t> deck_pool = unseen;
+    std::vector<Node*> path;
+    int64_t local_iterations = 0;
+
+    for (;;) {
+      if (options.max_iterations > 0 &&
+          claimed.fetch_add(1, std::memory_order_relaxed) >=
+              options.max_iterations) {
+        break;
+      }
+      if (options.time_budget_ms > 0.0) {
+        if (out_of_time.load(std::memory_order_relaxed)) {
+          break;
+        }
+        if (local_iterations % kClockCheckInterval == 0) {
+          const std::chrono::duration<double, std::milli> elapsed =
+              std::chrono::steady_clock::now() - start;
+          if (elapsed.count() >= options.time_budget_ms) {
+            out_of_time.store(true, std::memory_order_relaxed);
+            break;
+          }
+        }
+      }
+      ++local_iterations;
+
+      // Determinize the hidden cards.
+      GameSnapshot snapshot = root_snapshot;
+      for (size_t i = 0; i < hidden_slots.size(); ++i) {
+        std::uniform_int_distribution<size_t> pick(i, deck_pool.size() - 1);
+        std::swap(deck_pool[i], deck_pool[pick(rng)]);
+        snapshot.cards[hidden_slots[i]] = deck_pool[i];
+      }
+      sim.Restore(snapshot);
+
+      // Selection and expansion.
+      path.clear();
+      path.push_back(&root);
+      Node* node = &root;
+      while (!sim.is_terminal()) {
+        int chosen = -1;
+        for (int i = 0; i < node->num_actions; ++i) {
+          if (node->children[i].load(std::memory_order_acquire) == nullptr) {
+            chosen = i;
+            break;
+          }
+        }
+        if (chosen >= 0) {
+          sim.ApplyAction(node->actions[chosen]);
+          Node* fresh = arena.Allocate();
+          fresh->Init(sim);
+          Node* expected = nullptr;
+          if (!node->children[chosen].compare_exchange_strong(
+                  expected, fresh, std::memory_order_acq_rel)) {
+            // Another thread expanded it first; reuse our slot next time so
+            // result.nodes counts only linked nodes.
+            arena.ReleaseLast();
+            fresh = expected;
+          }
+          fresh->virtual_loss.fetch_add(1, std::memory_order_relaxed);
+          path.push_back(fresh);
+          break;
+        }
+
+        const double parent_visits =
+            std::max(1, node->visits.load(std::memory_order_relaxed));
+        const double log_parent = std::log(parent_visits);
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (int i = 0; i < node->num_actions; ++i) {
+          const Node* child = node->children[i].load(std::memory_order_acquire);
+          const int32_t loss = child->virtual_loss.load(std::memory_order_relaxed);
+          const double visits =
+              child->visits.load(std::memory_order_relaxed) + loss;
+          const double value =
+              child->value_sum.load(std::memory_order_relaxed) -
+              options.virtual_loss * loss;
+          const double score =
+              visits <= 0.0
+                  ? std::numeric_limits<double>::infinity()
+                  : value / visits +
+                        options.exploration * std::sqrt(log_parent / visits);
+          if (score > best_score) {
+            best_score = score;
+            chosen = i;
+          }
+        }
+        Node* child = node->children[chosen].load(std::memory_order_acquire);
+        child->virtual_loss.fetch_add(1, std::memory_order_relaxed);
+        sim.ApplyAction(node->actions[chosen]);
+        path.push_back(child);
+        node = child;
+      }
+
+      // Uniform random rollout.
+      while (!sim.is_terminal()) {
+        const auto legal = sim.LegalActions();
+        std::uniform_int_distribution<size_t> pick(0, legal.size() - 1);
+        sim.ApplyAction(legal[pick(rng)]);
+      }
+
+      // Backpropagation.
+      const auto payoffs = sim.payoffs();
+      root.visits.fetch_add(1, std::memory_order_relaxed);
+      for (size_t i = 1; i < path.size(); ++i) {
+        Node* child = path[i];
+        const int actor = path[i - 1]->player;
+        AtomicAdd(&child->value_sum, payoffs[actor] / big_bet);
+        child->visits.fetch_add(1, std::memory_order_relaxed);
+        child->virtual_loss.fetch_sub(1, std::memory_order_relaxed);
+      }
+      completed.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+
+  pool->ParallelFor(0, num_threads, 1,
+                    [&](size_t lane, size_t) { worker(lane); });
+
+  IsmctsResult result;
+  result.iterations = completed.load();
+  int64_t best_visits = -1;
+  for (int i = 0; i < root.num_actions; ++i) {
+    IsmctsActionStats stats;
+    stats.action = root.actions[i];
+    const Node* child = root.children[i].load();
+    if (child) {
+      stats.visits = child->visits.load();
+      if (stats.visits > 0) {
+        stats.mean_value = child->value_sum.load() / stats.visits * big_bet;
+      }
+    }
+    if (stats.visits > best_visits) {
+      best_visits = stats.visits;
+      result.best_action = stats.action;
+    }
+    result.actions.push_back(stats);
+  }
+  for (const NodeArena& arena : arenas) {
+    result.nodes += arena.size();
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  result.elapsed_ms = elapsed.count();
+  return result;
+}
+
+}  // namespace pokerbot::core
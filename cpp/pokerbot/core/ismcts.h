@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "limit_holdem_game.h"
+
+namespace pokerbot::core {
+
+struct IsmctsOptions {
+  // Concurrent lanes on the shared pool; 0 uses the pool size.
+  int num_threads = 0;
+  // Total playouts across all threads; 0 means unlimited.
+  int64_t max_iterations = 10000;
+  // Wall-clock budget in milliseconds; 0 means unlimited. At least one of
+  // max_iterations and time_budget_ms must be set.
+  double time_budget_ms = 0.0;
+  // UCT exploration constant, in big bets.
+  double exploration = 2.0;
+  // Penalty (in big bets) applied per in-flight playout through an edge so
+  // that concurrent threads spread over different branches.
+  double virtual_loss = 1.0;
+  uint64_t seed = 0;
+};
+
+struct IsmctsActionStats {
+  ActionType action = ActionType::kFold;
+  int64_t visits = 0;
+  // Mean payoff for the searching player, in chips.
+  double mean_value = 0.0;
+};
+
+struct IsmctsResult {
+  ActionType best_action = ActionType::kFold;
+  std::vector<IsmctsActionStats> actions;
+  int64_t iterations = 0;
+  double elapsed_ms = 0.0;
+  size_t nodes = 0;
+};
+
+// Information-set MCTS for the player to act in `state`. Every playout
+// determinizes the opponent's hole cards and the undealt board uniformly
+// from the unseen cards, then descends a tree keyed on the public action
+// sequence shared by all threads. Nodes live in per-thread arenas that are
+// released when the search returns. Throws std::invalid_argument for a
+// terminal state or an unbounded budget.
+IsmctsResult RunIsmcts(const GameState& state, const IsmctsOptions& options);
+
+}  // namespace pokerbot::core
@@ -4,13 +4,72 @@
 #include <numeric>
 #include <stdexcept>
 
-#include "hand_evaluator.h"
-
 namespace pokerbot::core {
 namespace {
 
 constexpr int Opponent(int player) { return 1 - player; }
 
+constexpr int kDealtCardCount = 9;
+constexpr uint8_t kSnapshotBetMade = 0x1;
+constexpr uint8_t kSnapshotTerminal = 0x2;
+constexpr int kSnapshotReasonShift = 2;
+
+// Two-bit history codes used by GameSnapshot.
+constexpr uint64_t kHistoryFold = 0;
+constexpr uint64_t kHistoryPassive = 1;
+constexpr uint64_t kHistoryAggressive = 2;
+
+uint64_t HistoryCode(ActionType action) {
+  switch (action) {
+    case ActionType::kFold:
+      return kHistoryFold;
+    case ActionType::kCheck:
+    case ActionType::kCall:
+      return kHistoryPassive;
+    case ActionType::kBet:
+    case ActionType::kRaise:
+      return kHistoryAggressive;
+  }
+  return kHistoryFold;
+}
+
+// Rebuilds the full action log from two-bit codes by tracking only the
+// betting structure (who acts, whether a bet is faced, when rounds close).
+void DecodeHistory(uint64_t code, int length,
+                   std::vector<ActionLogEntry>* history) {
+  history->clear();
+  int round = 0;
+  int player = 0;
+  int round_first_player = 0;
+  bool bet_made = true;
+  bool facing_bet = true;
+  for (int i = 0; i < length; ++i) {
+    const uint64_t bits = (code >> (2 * i)) & 0x3;
+    ActionType action = ActionType::kFold;
+    bool round_complete = false;
+    if (bits == kHistoryPassive) {
+      action = facing_bet ? ActionType::kCall : ActionType::kCheck;
+      round_complete = facing_bet || Opponent(player) == round_first_player;
+    } else if (bits == kHistoryAggressive) {
+      action = bet_made ? ActionType::kRaise : ActionType::kBet;
+      bet_made = true;
+      facing_bet = true;
+    } else if (bits != kHistoryFold) {
+      throw std::invalid_argument("Invalid snapshot history code");
+    }
+    history->push_back(ActionLogEntry{player, round, action});
+    if (round_complete) {
+      ++round;
+      player = 1;
+      round_first_player = 1;
+      bet_made = false;
+      facing_bet = false;
+    } else {
+      player = Opponent(player);
+    }
+  }
+}
+
 }  // namespace
 
 GameState::GameState(GameConfig config) : config_(config) {
@@ -25,6 +84,13 @@ void GameState::Reset(uint64_t seed) {
 }
 
 void GameState::ResetWithDeck(const std::array<uint8_t, kDeckSize>& deck) {
+  uint64_t seen = 0;
+  for (uint8_t card : deck) {
+    if (!IsValidCard(card) || (seen & (uint64_t{1} << card)) != 0) {
+      throw std::invalid_argument("Deck is not a permutation of 52 cards");
+    }
+    seen |= uint64_t{1} << card;
+  }
   deck_ = deck;
   InitializeHand();
 }
@@ -41,6 +107,7 @@ void GameState::InitializeHand() {
     board_cards_[i] = deck_[deck_position_++];
   }
   board_count_ = 0;
+  board_evaluator_.Reset();
 
   betting_round_ = 0;
   current_player_ = 0;
@@ -64,6 +131,92 @@ void GameState::InitializeHand() {
   action_history_.clear();
 }
 
+GameSnapshot GameState::Snapshot() const {
+  if (action_history_.size() > static_cast<size_t>(kMaxSnapshotActions)) {
+    throw std::length_error("Action history too long for GameSnapshot");
+  }
+  GameSnapshot snapshot;
+  for (size_t i = 0; i < action_history_.size(); ++i) {
+    snapshot.history_code |= HistoryCode(action_history_[i].action) << (2 * i);
+  }
+  for (int player = 0; player < kNumPlayers; ++player) {
+    snapshot.total_contribution[player] =
+        static_cast<int32_t>(total_contribution_[player]);
+    snapshot.round_contribution[player] =
+        static_cast<int32_t>(round_contribution_[player]);
+    snapshot.payoffs[player] = static_cast<int32_t>(payoffs_[player]);
+  }
+  snapshot.pot = static_cast<int32_t>(pot_);
+  snapshot.current_bet = static_cast<int32_t>(current_bet_);
+  std::copy(deck_.begin(), deck_.begin() + kDealtCardCount,
+            snapshot.cards.begin());
+  snapshot.history_length = static_cast<uint8_t>(action_history_.size());
+  snapshot.betting_round = static_cast<int8_t>(betting_round_);
+  snapshot.current_player = static_cast<int8_t>(current_player_);
+  snapshot.round_first_player = static_cast<int8_t>(round_first_player_);
+  snapshot.raises_in_round = static_cast<int8_t>(raises_in_round_);
+  snapshot.board_count = static_cast<int8_t>(board_count_);
+  snapshot.winner = static_cast<int8_t>(winner_);
+  snapshot.flags =
+      (bet_made_in_round_ ? kSnapshotBetMade : 0) |
+      (terminal_ ? kSnapshotTerminal : 0) |
+      static_cast<uint8_t>(static_cast<int>(terminal_reason_)
+                           << kSnapshotReasonShift);
+  return snapshot;
+}
+
+void GameState::Restore(const GameSnapshot& snapshot) {
+  if (snapshot.history_length > kMaxSnapshotActions) {
+    throw std::invalid_argument("Invalid snapshot history length");
+  }
+  if (snapshot.board_count < 0 || snapshot.board_count > 5) {
+    throw std::invalid_argument("Invalid snapshot board count");
+  }
+  uint64_t used = 0;
+  for (int i = 0; i < kDealtCardCount; ++i) {
+    const uint8_t card = snapshot.cards[i];
+    if (!IsValidCard(card) || (used & (uint64_t{1} << card)) != 0) {
+      throw std::invalid_argument("Invalid snapshot cards");
+    }
+    used |= uint64_t{1} << card;
+  }
+  DecodeHistory(snapshot.history_code, snapshot.history_length,
+                &action_history_);
+
+  std::copy(snapshot.cards.begin(), snapshot.cards.end(), deck_.begin());
+  int next = kDealtCardCount;
+  for (int card = 0; card < kDeckSize; ++card) {
+    if ((used & (uint64_t{1} << card)) == 0) {
+      deck_[next++] = static_cast<uint8_t>(card);
+    }
+  }
+  hole_cards_[0] = {deck_[0], deck_[2]};
+  hole_cards_[1] = {deck_[1], deck_[3]};
+  std::copy(deck_.begin() + 4, deck_.begin() + kDealtCardCount,
+            board_cards_.begin());
+  deck_position_ = kDealtCardCount;
+  board_count_ = 0;
+  board_evaluator_.Reset();
+  ExposeBoardCards(snapshot.board_count);
+
+  betting_round_ = snapshot.betting_round;
+  current_player_ = snapshot.current_player;
+  round_first_player_ = snapshot.round_first_player;
+  for (int player = 0; player < kNumPlayers; ++player) {
+    total_contribution_[player] = snapshot.total_contribution[player];
+    round_contribution_[player] = snapshot.round_contribution[player];
+    payoffs_[player] = snapshot.payoffs[player];
+  }
+  pot_ = snapshot.pot;
+  current_bet_ = snapshot.current_bet;
+  raises_in_round_ = snapshot.raises_in_round;
+  bet_made_in_round_ = (snapshot.flags & kSnapshotBetMade) != 0;
+  terminal_ = (snapshot.flags & kSnapshotTerminal) != 0;
+  terminal_reason_ =
+      static_cast<TerminalReason>((snapshot.flags >> kSnapshotReasonShift) & 0x3);
+  winner_ = snapshot.winner;
+}
+
 int64_t GameState::ToCall(int player) const {
   if (player < 0 || player >= kNumPlayers) {
     throw std::out_of_range("Invalid player index");
@@ -93,38 +246,56 @@ const std::array<uint8_t, 2>& GameState::hole_cards(int player) const {
   return hole_cards_[player];
 }
 
+uint64_t GameState::HandStrength(int player) const {
+  return HandStrength(hole_cards(player));
+}
+
+uint64_t GameState::HandStrength(
+    const std::array<uint8_t, 2>& hole_cards) const {
+  return board_evaluator_.Evaluate(hole_cards);
+}
+
 std::vector<uint8_t> GameState::board_cards() const {
   return std::vector<uint8_t>(board_cards_.begin(),
                               board_cards_.begin() + board_count_);
 }
 
-std::vector<ActionType> GameState::LegalActions() const {
+uint32_t GameState::LegalActionMask() const {
   if (terminal_) {
-    return {};
+    return 0;
   }
 
-  const int player = current_player_;
-  const int64_t to_call = ToCall(player);
-  std::vector<ActionType> actions;
-  actions.reserve(3);
+  const int64_t to_call = current_bet_ - round_contribution_[current_player_];
   const bool raise_available =
       bet_made_in_round_ && (raises_in_round_ < config_.max_raises_per_round);
+  uint32_t mask = 0;
 
   if (to_call > 0) {
-    actions.push_back(ActionType::kFold);
-    actions.push_back(ActionType::kCall);
+    mask |= ActionBit(ActionType::kFold) | ActionBit(ActionType::kCall);
     if (raise_available) {
-      actions.push_back(ActionType::kRaise);
+      mask |= ActionBit(ActionType::kRaise);
     }
   } else {
-    actions.push_back(ActionType::kCheck);
+    mask |= ActionBit(ActionType::kCheck);
     if (!bet_made_in_round_) {
-      actions.push_back(ActionType::kBet);
+      mask |= ActionBit(ActionType::kBet);
     } else if (raise_available) {
-      actions.push_back(ActionType::kRaise);
+      mask |= ActionBit(ActionType::kRaise);
     }
   }
 
+  return mask;
+}
+
+std::vector<ActionType> GameState::LegalActions() const {
+  const uint32_t mask = LegalActionMask();
+  std::vector<ActionType> actions;
+  actions.reserve(3);
+  for (int action = 0; action < kNumActionTypes; ++action) {
+    if ((mask & (1u << action)) != 0) {
+      actions.push_back(static_cast<ActionType>(action));
+    }
+  }
   return actions;
 }
 
@@ -147,8 +318,9 @@ bool GameState::ApplyAction(ActionType action) {
     return false;
   }
 
-  const auto legal = LegalActions();
-  if (std::find(legal.begin(), legal.end(), action) == legal.end()) {
+  const int action_index = static_cast<int>(action);
+  if (action_index < 0 || action_index >= kNumActionTypes ||
+      (LegalActionMask() & ActionBit(action)) == 0) {
     return false;
   }
 
@@ -231,11 +403,11 @@ void GameState::AdvanceRound() {
   ++betting_round_;
 
   if (betting_round_ == 1) {
-    board_count_ = 3;
+    ExposeBoardCards(3);
   } else if (betting_round_ == 2) {
-    board_count_ = 4;
+    ExposeBoardCards(4);
   } else if (betting_round_ == 3) {
-    board_count_ = 5;
+    ExposeBoardCards(5);
   } else {
     ResolveShowdown();
     return;
@@ -245,6 +417,12 @@ void GameState::AdvanceRound() {
   round_first_player_ = current_player_;
 }
 
+void GameState::ExposeBoardCards(int count) {
+  while (board_count_ < count) {
+    board_evaluator_.AddCard(board_cards_[board_count_++]);
+  }
+}
+
 void GameState::ResolveFold(int folding_player) {
   terminal_ = true;
   terminal_reason_ = TerminalReason::kFold;
@@ -257,20 +435,11 @@ void GameState::ResolveFold(int folding_player) {
 void GameState::ResolveShowdown() {
   terminal_ = true;
   terminal_reason_ = TerminalReason::kShowdown;
-  board_count_ = 5;
-
-  std::vector<uint8_t> board(board_cards_.begin(),
-                             board_cards_.begin() + board_count_);
-
-  std::vector<uint8_t> hand0 = board;
-  hand0.push_back(hole_cards_[0][0]);
-  hand0.push_back(hole_cards_[0][1]);
-
-  std::vector<uint8_t> hand1 = board;
-  hand1.push_back(hole_cards_[1][0]);
-  hand1.push_back(hole_cards_[1][1]);
+  ExposeBoardCards(5);
 
-  const int cmp = CompareHands(hand0, hand1);
+  const uint64_t value0 = board_evaluator_.Evaluate(hole_cards_[0]);
+  const uint64_t value1 = board_evaluator_.Evaluate(hole_cards_[1]);
+  const int cmp = (value0 > value1) - (value0 < value1);
   if (cmp > 0) {
     winner_ = 0;
     payoffs_[0] = pot_ - total_contribution_[0];
@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <optional>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 #include "cards.h"
+#include "hand_evaluator.h"
 
 namespace pokerbot::core {
 
@@ -20,6 +22,12 @@ enum class ActionType : int {
   kRaise = 4,
 };
 
+constexpr int kNumActionTypes = 5;
+
+constexpr uint32_t ActionBit(ActionType action) {
+  return 1u << static_cast<int>(action);
+}
+
 enum class TerminalReason : int {
   kNone = 0,
   kFold = 1,
@@ -40,16 +48,63 @@ struct ActionLogEntry {
   ActionType action = ActionType::kFold;
 };
 
+// Trivially-copyable image of a GameState that fits in one cache line.
+// Only the nine dealt cards are kept; the action history is packed two bits
+// per action (fold, check/call, bet/raise) and rebuilt on restore.
+struct alignas(64) GameSnapshot {
+  uint64_t history_code = 0;
+  std::array<int32_t, kNumPlayers> total_contribution{};
+  std::array<int32_t, kNumPlayers> round_contribution{};
+  std::array<int32_t, kNumPlayers> payoffs{};
+  int32_t pot = 0;
+  int32_t current_bet = 0;
+  std::array<uint8_t, 9> cards{};
+  uint8_t history_length = 0;
+  int8_t betting_round = 0;
+  int8_t current_player = 0;
+  int8_t round_first_player = 0;
+  int8_t raises_in_round = 0;
+  int8_t board_count = 0;
+  int8_t winner = -1;
+  uint8_t flags = 0;
+  // Explicit tail so snapshots compare and hash bytewise.
+  std::array<uint8_t, 7> reserved{};
+};
+
+static_assert(sizeof(GameSnapshot) == 64, "GameSnapshot must be one cache line");
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+              "GameSnapshot must be trivially copyable");
+static_assert(std::has_unique_object_representations<GameSnapshot>::value,
+              "GameSnapshot fields must cover every byte (no padding)");
+
+// Longest action history a GameSnapshot can encode: history_code holds two
+// bits per action.
+constexpr int kMaxSnapshotActions = 32;
+
+// Longest possible hand under `max_raises_per_round`. Preflop the blind is
+// the opening bet, so at most the raises plus a closing call; each later
+// round adds a check, the bet, the raises and a call.
+constexpr int MaxHandActions(int max_raises_per_round) {
+  return (max_raises_per_round + 1) + 3 * (max_raises_per_round + 3);
+}
+
+static_assert(MaxHandActions(GameConfig().max_raises_per_round) <=
+                  kMaxSnapshotActions,
+              "Default hands must fit in a GameSnapshot");
+
 class GameState {
  public:
   explicit GameState(GameConfig config = GameConfig());
 
   void Reset(uint64_t seed);
 
-  // Provides a deterministic reset using a predefined deck ordering.
+  // Provides a deterministic reset using a predefined deck ordering. Throws
+  // std::invalid_argument, leaving the state untouched, unless `deck` is a
+  // permutation of the 52 cards.
   void ResetWithDeck(const std::array<uint8_t, kDeckSize>& deck);
 
   const GameConfig& config() const { return config_; }
+  const std::array<uint8_t, kDeckSize>& deck() const { return deck_; }
 
   int current_player() const { return current_player_; }
   int betting_round() const { return betting_round_; }
@@ -70,6 +125,12 @@ class GameState {
   std::vector<uint8_t> board_cards() const;
   int board_card_count() const { return board_count_; }
 
+  // Best-hand value of the player's hole cards plus the exposed board, on the
+  // EvaluateBestHand() scale once the flop is out.
+  uint64_t HandStrength(int player) const;
+  // Same scale for arbitrary hole cards, e.g. a hypothetical opponent hand.
+  uint64_t HandStrength(const std::array<uint8_t, 2>& hole_cards) const;
+
   const std::vector<ActionLogEntry>& action_history() const {
     return action_history_;
   }
@@ -77,10 +138,21 @@ class GameState {
   std::array<int64_t, kNumPlayers> payoffs() const { return payoffs_; }
 
   std::vector<ActionType> LegalActions() const;
+  // Legal actions as a bitmask of ActionBit() values; allocation free.
+  uint32_t LegalActionMask() const;
   bool ApplyAction(ActionType action);
 
+  // Captures the hand so it can be resumed with Restore() on a state with the
+  // same config. Throws std::length_error if the history exceeds
+  // kMaxSnapshotActions, which takes more than five raises per round (see
+  // MaxHandActions). After Restore(), deck() holds the dealt cards followed
+  // by the undealt cards in ascending order.
+  GameSnapshot Snapshot() const;
+  void Restore(const GameSnapshot& snapshot);
+
  private:
   void InitializeHand();
+  void ExposeBoardCards(int count);
   void AdvanceRound();
   void ResolveFold(int folding_player);
   void ResolveShowdown();
@@ -94,6 +166,7 @@ class GameState {
   std::array<std::array<uint8_t, 2>, kNumPlayers> hole_cards_{};
   std::array<uint8_t, 5> board_cards_{};
   int board_count_ = 0;
+  BoardEvaluator board_evaluator_;
 
   int betting_round_ = 0;
   int current_player_ = 0;
@@ -0,0 +1,165 @@
+#include "opponent_range.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace pokerbot::core {
+namespace {
+
+constexpr uint64_t kAllCards = (uint64_t{1} << kDeckSize) - 1;
+// Partial sums run in this many independent lanes so the loop vectorizes.
+constexpr int kSumLanes = 16;
+// Weights are renormalized once their total drops below this.
+constexpr double kRescaleBelow = 1e-6;
+
+static_assert(kPaddedCombos % kSumLanes == 0, "Padding must fit the lanes");
+
+uint64_t CardBit(uint8_t card) { return uint64_t{1} << card; }
+
+double Sum(const float* values) {
+  float lanes[kSumLanes] = {};
+  for (int i = 0; i < kPaddedCombos; i += kSumLanes) {
+    for (int j = 0; j < kSumLanes; ++j) {
+      lanes[j] += values[i + j];
+    }
+  }
+  double total = 0.0;
+  for (float lane : lanes) {
+    total += lane;
+  }
+  return total;
+}
+
+}  // namespace
+
+const std::array<uint8_t, 2>& ComboCards(int index) {
+  static const auto kCombos = [] {
+    std::array<std::array<uint8_t, 2>, kNumCombos> combos{};
+    for (int hi = 1; hi < kDeckSize; ++hi) {
+      for (int lo = 0; lo < hi; ++lo) {
+        combos[ComboIndex(static_cast<uint8_t>(hi), static_cast<uint8_t>(lo))] =
+            {static_cast<uint8_t>(lo), static_cast<uint8_t>(hi)};
+      }
+    }
+    return combos;
+  }();
+  return kCombos.at(static_cast<size_t>(index));
+}
+
+OpponentRange::OpponentRange() { Reset(); }
+
+void OpponentRange::Reset() {
+  std::fill(weights_.begin(), weights_.begin() + kNumCombos, 1.0f);
+  std::fill(weights_.begin() + kNumCombos, weights_.end(), 0.0f);
+  scratch_.fill(0.0f);
+  total_ = kNumCombos;
+  dead_cards_ = 0;
+  actions_observed_ = 0;
+  has_hand_ = false;
+}
+
+void OpponentRange::RemoveCards(uint64_t mask) {
+  uint64_t fresh = mask & kAllCards & ~dead_cards_;
+  if (fresh == 0) {
+    return;
+  }
+  dead_cards_ |= fresh;
+  for (uint8_t card = 0; card < kDeckSize; ++card) {
+    if ((fresh & CardBit(card)) == 0) {
+      continue;
+    }
+    for (uint8_t other = 0; other < kDeckSize; ++other) {
+      if (other != card) {
+        weights_[ComboIndex(card, other)] = 0.0f;
+      }
+    }
+  }
+  total_ = Sum(weights_.data());
+}
+
+bool OpponentRange::Update(const float* likelihood) {
+  const float* __restrict in = weights_.data();
+  float* __restrict out = scratch_.data();
+  for (int i = 0; i < kNumCombos; ++i) {
+    out[i] = in[i] * std::max(0.0f, likelihood[i]);
+  }
+  const double total = Sum(out);
+  if (!(total > 0.0)) {
+    return false;
+  }
+  std::swap(weights_, scratch_);
+  total_ = total;
+  if (total_ < kRescaleBelow) {
+    Rescale();
+  }
+  return true;
+}
+
+void OpponentRange::Rescale() {
+  const auto scale = static_cast<float>(1.0 / total_);
+  for (float& weight : weights_) {
+    weight *= scale;
+  }
+  total_ = Sum(weights_.data());
+}
+
+bool OpponentRange::Observe(const GameState& state, int observer,
+                            const ActionLikelihoodFn& likelihood) {
+  if (observer < 0 || observer >= kNumPlayers) {
+    throw std::invalid_argument("Observer must be 0 or 1");
+  }
+  const std::vector<ActionLogEntry>& history = state.action_history();
+  if (has_hand_) {
+    if (replay_.deck() != state.deck()) {
+      throw std::invalid_argument("State is from a different hand");
+    }
+    if (history.size() < actions_observed_) {
+      throw std::invalid_argument("State is behind the observed history");
+    }
+    if (history.size() == actions_observed_) {
+      return true;
+    }
+  } else {
+    replay_ = GameState(state.config());
+    replay_.ResetWithDeck(state.deck());
+    has_hand_ = true;
+  }
+
+  // The checks above passed, so the cards seen now belong to this hand.
+  uint64_t visible = 0;
+  for (uint8_t card : state.hole_cards(observer)) {
+    visible |= CardBit(card);
+  }
+  for (uint8_t card : state.board_cards()) {
+    visible |= CardBit(card);
+  }
+  RemoveCards(visible);
+
+  alignas(64) std::array<float, kNumCombos> probabilities;
+  bool consistent = true;
+  for (size_t i = actions_observed_; i < history.size(); ++i) {
+    const ActionLogEntry& entry = history[i];
+    if ((replay_.LegalActionMask() & ActionBit(entry.action)) == 0) {
+      throw std::invalid_argument("Action history does not replay");
+    }
+    if (entry.player != observer) {
+      likelihood(replay_, entry.action, probabilities.data());
+      consistent = Update(probabilities.data()) && consistent;
+    }
+    replay_.ApplyAction(entry.action);
+    // Advance per action so a throwing callback leaves the cursor in step
+    // with the weights.
+    actions_observed_ = i + 1;
+  }
+  return consistent;
+}
+
+void OpponentRange::Normalized(float* out) const {
+  const float scale = total_ > 0.0 ? static_cast<float>(1.0 / total_) : 0.0f;
+  for (int i = 0; i < kNumCombos; ++i) {
+    out[i] = weights_[i] * scale;
+  }
+}
+
+}  // namespace pokerbot::core
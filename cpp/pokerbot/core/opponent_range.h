@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "cards.h"
+#include "limit_holdem_game.h"
+
+namespace pokerbot::core {
+
+// Distinct two-card holdings.
+constexpr int kNumCombos = kDeckSize * (kDeckSize - 1) / 2;
+// Weight arrays are padded to whole cache lines so update loops run over a
+// fixed, vector-friendly trip count.
+constexpr int kPaddedCombos = (kNumCombos + 15) / 16 * 16;
+
+// Index of the holding {a, b} (order-insensitive, a != b). Holdings are
+// ordered by their higher card, then their lower card.
+inline int ComboIndex(uint8_t a, uint8_t b) {
+  const int hi = a > b ? a : b;
+  const int lo = a > b ? b : a;
+  return hi * (hi - 1) / 2 + lo;
+}
+
+// Cards of holding `index`, lower card first.
+const std::array<uint8_t, 2>& ComboCards(int index);
+
+// Per-combo probabilities of an observed action, given the state before it.
+using ActionLikelihoodFn =
+    std::function<void(const GameState& before, ActionType action, float* out)>;
+
+// Posterior weights over the opponent's 1326 holdings. Actions multiply in
+// the acting policy's per-combo probabilities; revealed cards zero every
+// holding that contains them. Weights are unnormalized and rescaled when
+// they grow small, so long hands do not underflow.
+class OpponentRange {
+ public:
+  OpponentRange();
+
+  // Uniform over all holdings, no dead cards, no actions observed.
+  void Reset();
+
+  // Zeroes every holding that contains a card of `mask` (bit c = card c).
+  void RemoveCards(uint64_t mask);
+
+  // weight[i] *= likelihood[i] over kNumCombos entries. Evidence that no
+  // live holding can explain leaves the range unchanged and returns false.
+  bool Update(const float* likelihood);
+
+  // Brings the range up to date with `state` as seen by `observer`: removes
+  // the observer's hole cards and the exposed board, then applies
+  // `likelihood` for each opponent action in state.action_history() not yet
+  // observed. Only the new actions are replayed, so following a hand costs
+  // O(actions) in total, and a call with no new actions changes nothing.
+  // Returns false if some action was inconsistent (and skipped). Throws
+  // std::invalid_argument, before touching the range, if `state` deals a
+  // different deck or its history is shorter than what was already
+  // observed; call Reset() between hands.
+  bool Observe(const GameState& state, int observer,
+               const ActionLikelihoodFn& likelihood);
+
+  double total() const { return total_; }
+  uint64_t dead_cards() const { return dead_cards_; }
+  size_t actions_observed() const { return actions_observed_; }
+  // kNumCombos unnormalized weights.
+  const float* weights() const { return weights_.data(); }
+  // Writes kNumCombos probabilities summing to one (all zero when empty).
+  void Normalized(float* out) const;
+
+ private:
+  void Rescale();
+
+  alignas(64) std::array<float, kPaddedCombos> weights_;
+  alignas(64) std::array<float, kPaddedCombos> scratch_;
+  double total_ = 0.0;
+  uint64_t dead_cards_ = 0;
+  size_t actions_observed_ = 0;
+  // Set by the first Observe() after Reset(); replay_ then holds its deck.
+  bool has_hand_ = false;
+  // The observed hand replayed through actions_observed_, so each new
+  // action is scored against the state it was taken in.
+  GameState replay_;
+};
+
+}  // namespace pokerbot::core
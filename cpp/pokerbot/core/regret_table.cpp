@@ -0,0 +1,193 @@
+#include "regret_table.h"
+
+#include <new>
+#include <stdexcept>
+
+namespace pokerbot::core {
+namespace {
+
+// Key 0 marks an empty slot; callers' keys are remapped away from it.
+constexpr uint64_t kEmptyKey = 0;
+
+uint64_t StoredKey(uint64_t key) { return key == kEmptyKey ? 1 : key; }
+
+static_assert(sizeof(std::atomic<double>) == sizeof(double) &&
+                  std::atomic<double>::is_always_lock_free,
+              "Shared accumulators require lock-free double atomics");
+
+std::atomic<double>* AsAtomic(double* value) {
+  return reinterpret_cast<std::atomic<double>*>(value);
+}
+
+const std::atomic<double>* AsAtomic(const double* value) {
+  return reinterpret_cast<const std::atomic<double>*>(value);
+}
+
+void AtomicUpdate(double* target, double delta, bool floor_at_zero) {
+  std::atomic<double>* value = AsAtomic(target);
+  double current = value->load(std::memory_order_relaxed);
+  double updated;
+  do {
+    updated = current + delta;
+    if (floor_at_zero && updated < 0.0) {
+      updated = 0.0;
+    }
+  } while (!value->compare_exchange_weak(current, updated,
+                                         std::memory_order_relaxed));
+}
+
+uint64_t Mix(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xFF51AFD7ED558CCDull;
+  key ^= key >> 33;
+  return key;
+}
+
+}  // namespace
+
+size_t RegretTable::RoundCapacity(size_t capacity) {
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  return rounded;
+}
+
+size_t RegretTable::BytesFor(size_t capacity) {
+  capacity = RoundCapacity(capacity);
+  return sizeof(Header) + capacity * sizeof(uint64_t) +
+         2 * capacity * kMaxInfoSetActions * sizeof(double);
+}
+
+RegretTable::RegretTable(size_t capacity)
+    : capacity_(RoundCapacity(capacity)) {
+  owned_.resize((BytesFor(capacity_) + sizeof(uint64_t) - 1) /
+                sizeof(uint64_t));
+  Bind(owned_.data(), true);
+}
+
+RegretTable::RegretTable(void* memory, size_t capacity, bool initialize)
+    : capacity_(RoundCapacity(capacity)) {
+  if (!memory) {
+    throw std::invalid_argument("RegretTable requires memory");
+  }
+  Bind(memory, initialize);
+  if (header_->capacity != capacity_) {
+    throw std::invalid_argument("RegretTable capacity does not match memory");
+  }
+}
+
+void RegretTable::Bind(void* memory, bool initialize) {
+  auto* bytes = static_cast<unsigned char*>(memory);
+  header_ = initialize ? new (bytes) Header{capacity_, {0}}
+                       : reinterpret_cast<Header*>(bytes);
+  bytes += sizeof(Header);
+  keys_ = reinterpret_cast<std::atomic<uint64_t>*>(bytes);
+  if (initialize) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      new (&keys_[i]) std::atomic<uint64_t>(kEmptyKey);
+    }
+  }
+  bytes += capacity_ * sizeof(uint64_t);
+  regrets_ = reinterpret_cast<double*>(bytes);
+  bytes += capacity_ * kMaxInfoSetActions * sizeof(double);
+  strategy_sum_ = reinterpret_cast<double*>(bytes);
+  if (initialize) {
+    for (size_t i = 0; i < capacity_ * kMaxInfoSetActions; ++i) {
+      regrets_[i] = 0.0;
+      strategy_sum_[i] = 0.0;
+    }
+  }
+}
+
+size_t RegretTable::size() const {
+  return static_cast<size_t>(header_->size.load(std::memory_order_relaxed));
+}
+
+size_t RegretTable::FindOrInsert(uint64_t key) {
+  key = StoredKey(key);
+  const size_t mask = capacity_ - 1;
+  size_t slot = Mix(key) & mask;
+  for (size_t probe = 0; probe < capacity_; ++probe) {
+    uint64_t current = keys_[slot].load(std::memory_order_acquire);
+    if (current == key) {
+      return slot;
+    }
+    if (current == kEmptyKey) {
+      if (keys_[slot].compare_exchange_strong(current, key,
+                                              std::memory_order_acq_rel)) {
+        header_->size.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+      }
+      if (current == key) {
+        return slot;
+      }
+    }
+    slot = (slot + 1) & mask;
+  }
+  throw std::length_error("RegretTable is full");
+}
+
+size_t RegretTable::Find(uint64_t key) const {
+  key = StoredKey(key);
+  const size_t mask = capacity_ - 1;
+  size_t slot = Mix(key) & mask;
+  for (size_t probe = 0; probe < capacity_; ++probe) {
+    const uint64_t current = keys_[slot].load(std::memory_order_acquire);
+    if (current == key) {
+      return slot;
+    }
+    if (current == kEmptyKey) {
+      return capacity_;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return capacity_;
+}
+
+void RegretTable::LoadRegrets(size_t slot, double* out) const {
+  const double* regret = regrets(slot);
+  for (int a = 0; a < kMaxInfoSetActions; ++a) {
+    out[a] = concurrent() ? AsAtomic(regret + a)->load(std::memory_order_relaxed)
+                          : regret[a];
+  }
+}
+
+void RegretTable::AddRegret(size_t slot, int action, double delta,
+                            bool floor_at_zero) {
+  double* regret = regrets(slot) + action;
+  if (concurrent()) {
+    AtomicUpdate(regret, delta, floor_at_zero);
+    return;
+  }
+  *regret += delta;
+  if (floor_at_zero && *regret < 0.0) {
+    *regret = 0.0;
+  }
+}
+
+void RegretTable::AddStrategySum(size_t slot, int action, double delta) {
+  double* sum = strategy_sum(slot) + action;
+  if (concurrent()) {
+    AtomicUpdate(sum, delta, false);
+    return;
+  }
+  *sum += delta;
+}
+
+void RegretTable::Scale(double positive_regret, double negative_regret,
+                        double strategy) {
+  for (size_t slot = 0; slot < capacity_; ++slot) {
+    if (keys_[slot].load(std::memory_order_relaxed) == kEmptyKey) {
+      continue;
+    }
+    double* regret = regrets(slot);
+    double* sum = strategy_sum(slot);
+    for (int a = 0; a < kMaxInfoSetActions; ++a) {
+      regret[a] *= regret[a] > 0.0 ? positive_regret : negative_regret;
+      sum[a] *= strategy;
+    }
+  }
+}
+
+}  // namespace pokerbot::core
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pokerbot::core {
+
+// Most actions available at any limit Hold'em decision.
+constexpr int kMaxInfoSetActions = 3;
+
+// Open-addressing table from information-set keys to regret and average
+// strategy accumulators. All state lives in one flat block (keys, then
+// regrets, then strategy sums) so the table can sit in owned memory or in a
+// caller-provided region such as a shared-memory segment. Lookups and inserts
+// are lock-free. Accumulator updates are plain stores on owned tables and
+// relaxed atomic read-modify-writes on caller-provided memory, which other
+// threads or processes may be updating at the same time. Accumulators are
+// doubles: long runs add small reach-weighted deltas to large sums, which
+// float would round away.
+class RegretTable {
+ public:
+  // Owns its storage. `capacity` is rounded up to a power of two.
+  explicit RegretTable(size_t capacity);
+
+  // Uses `memory` (at least BytesFor(capacity) bytes, 8-byte aligned).
+  // When `initialize` is false the region is assumed to hold a table
+  // previously initialized with the same capacity.
+  RegretTable(void* memory, size_t capacity, bool initialize);
+
+  RegretTable(const RegretTable&) = delete;
+  RegretTable& operator=(const RegretTable&) = delete;
+
+  static size_t RoundCapacity(size_t capacity);
+  static size_t BytesFor(size_t capacity);
+
+  size_t capacity() const { return capacity_; }
+  size_t size() const;
+  // True when accumulator updates are atomic (caller-provided memory).
+  bool concurrent() const { return owned_.empty(); }
+  // Start of the flat block, BytesFor(capacity()) bytes long.
+  const void* data() const { return header_; }
+  void* data() { return header_; }
+
+  // Returns the slot for `key`, inserting it if needed. Throws
+  // std::length_error when the table is full.
+  size_t FindOrInsert(uint64_t key);
+  // Returns capacity() when `key` is absent.
+  size_t Find(uint64_t key) const;
+
+  double* regrets(size_t slot) {
+    return regrets_ + slot * kMaxInfoSetActions;
+  }
+  const double* regrets(size_t slot) const {
+    return regrets_ + slot * kMaxInfoSetActions;
+  }
+  double* strategy_sum(size_t slot) {
+    return strategy_sum_ + slot * kMaxInfoSetActions;
+  }
+  const double* strategy_sum(size_t slot) const {
+    return strategy_sum_ + slot * kMaxInfoSetActions;
+  }
+
+  // Copies the regrets for `slot`, tolerating concurrent updates.
+  void LoadRegrets(size_t slot, double* out) const;
+  // regret += delta, floored at zero when `floor_at_zero` (CFR+).
+  void AddRegret(size_t slot, int action, double delta, bool floor_at_zero);
+  void AddStrategySum(size_t slot, int action, double delta);
+
+  // Scales every populated accumulator; used by discounted CFR variants.
+  // Not atomic with respect to concurrent updates; callers quiesce writers.
+  void Scale(double positive_regret, double negative_regret, double strategy);
+
+ private:
+  struct Header {
+    uint64_t capacity;
+    std::atomic<uint64_t> size;
+  };
+
+  void Bind(void* memory, bool initialize);
+
+  std::vector<uint64_t> owned_;
+  size_t capacity_ = 0;
+  Header* header_ = nullptr;
+  std::atomic<uint64_t>* keys_ = nullptr;
+  double* regrets_ = nullptr;
+  double* strategy_sum_ = nullptr;
+};
+
+}  // namespace pokerbot::core
@@ -0,0 +1,182 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace pokerbot::core {
+namespace {
+
+void Accumulate(const ReplayResult& result, ReplaySummary* summary) {
+  ++summary->hands;
+  switch (result.status) {
+    case ReplayStatus::kOk:
+      ++summary->ok;
+      break;
+    case ReplayStatus::kIllegalAction:
+      ++summary->illegal_action;
+      break;
+    case ReplayStatus::kPayoffMismatch:
+      ++summary->payoff_mismatch;
+      break;
+    case ReplayStatus::kIncomplete:
+      ++summary->incomplete;
+      break;
+  }
+}
+
+}  // namespace
+
+ReplayResult ReplayHand(const HandRecord& record, size_t index,
+                        GameState* state,
+                        const ReplayDecisionVisitor& visitor) {
+  ReplayResult result;
+  result.index = index;
+  result.hand_id = record.hand_id;
+
+  state->ResetWithDeck(record.deck);
+  for (size_t i = 0; i < record.actions.size(); ++i) {
+    const ActionLogEntry& entry = record.actions[i];
+    if (state->is_terminal() || entry.player != state->current_player() ||
+        entry.betting_round != state->betting_round()) {
+      result.status = ReplayStatus::kIllegalAction;
+      result.failed_action = static_cast<int>(i);
+      return result;
+    }
+    if (visitor) {
+      visitor(index, *state, entry);
+    }
+    if (!state->ApplyAction(entry.action)) {
+      result.status = ReplayStatus::kIllegalAction;
+      result.failed_action = static_cast<int>(i);
+      return result;
+    }
+  }
+
+  if (!state->is_terminal()) {
+    result.status = ReplayStatus::kIncomplete;
+    return result;
+  }
+  result.replayed_payoffs = state->payoffs();
+  if (result.replayed_payoffs != record.payoffs ||
+      state->terminal_reason() != record.terminal_reason) {
+    result.status = ReplayStatus::kPayoffMismatch;
+  }
+  return result;
+}
+
+ReplaySummary ReplayHistory(const HandHistoryReader& reader,
+                            const ReplayOptions& options,
+                            const ReplayResultSink& sink,
+                            const ReplayDecisionVisitor& visitor) {
+  const size_t block_count = reader.block_count();
+  std::shared_ptr<ThreadPool> pool = DefaultThreadPool();
+  const int num_threads = std::max(
+      1, std::min<int>(options.num_threads > 0 ? options.num_threads
+                                               : pool->num_threads(),
+                       static_cast<int>(std::max<size_t>(block_count, 1))));
+
+  const size_t window = static_cast<size_t>(
+      options.max_buffered_blocks > 0 ? options.max_buffered_blocks
+                                      : 4 * num_threads);
+
+  ReplaySummary summary;
+  std::atomic<size_t> next_block{0};
+  std::atomic<bool> stop{false};
+  std::mutex emit_mutex;
+  // Signalled when next_to_emit advances or the replay stops.
+  std::condition_variable emitted;
+  std::map<size_t, std::vector<ReplayResult>> ready;
+  size_t next_to_emit = 0;
+  std::exception_ptr error;
+
+  auto emit = [&](const std::vector<ReplayResult>& results) {
+    for (const ReplayResult& result : results) {
+      Accumulate(result, &summary);
+      if (sink &&
+          (!options.failures_only || result.status != ReplayStatus::kOk)) {
+        sink(result);
+      }
+    }
+  };
+
+  auto worker = [&]() {
+    GameState state(reader.config());
+    std::vector<ReplayResult> results;
+    for (;;) {
+      if (stop.load(std::memory_order_relaxed)) {
+        return;
+      }
+      const size_t block = next_block.fetch_add(1);
+      if (block >= block_count) {
+        return;
+      }
+      if (options.ordered) {
+        // Backpressure: a slow early block must not let later results pile
+        // up without bound. The lane holding next_to_emit never waits.
+        std::unique_lock<std::mutex> lock(emit_mutex);
+        emitted.wait(lock, [&] {
+          return block < next_to_emit + window ||
+                 stop.load(std::memory_order_relaxed);
+        });
+        if (stop.load(std::memory_order_relaxed)) {
+          return;
+        }
+      }
+      results.clear();
+      results.reserve(reader.block_record_count(block));
+      try {
+        reader.DecodeBlock(block,
+                           [&](size_t index, const HandRecord& record) {
+                             results.push_back(
+                                 ReplayHand(record, index, &state, visitor));
+                             return true;
+                           });
+
+        std::lock_guard<std::mutex> lock(emit_mutex);
+        if (!options.ordered) {
+          emit(results);
+          continue;
+        }
+        ready.emplace(block, std::move(results));
+        results = std::vector<ReplayResult>();
+        const size_t emitted_before = next_to_emit;
+        for (auto it = ready.begin();
+             it != ready.end() && it->first == next_to_emit;
+             it = ready.erase(it)) {
+          emit(it->second);
+          ++next_to_emit;
+        }
+        if (next_to_emit != emitted_before) {
+          emitted.notify_all();
+        }
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(emit_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          stop.store(true);
+        }
+        emitted.notify_all();
+        return;
+      }
+    }
+  };
+
+  // Each lane drains blocks until none remain, so lanes balance themselves.
+  pool->ParallelFor(0, num_threads, 1, [&](size_t, size_t) { worker(); });
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return summary;
+}
+
+}  // namespace pokerbot::core
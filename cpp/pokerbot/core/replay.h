@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include "hand_history.h"
+#include "limit_holdem_game.h"
+
+namespace pokerbot::core {
+
+enum class ReplayStatus : int {
+  kOk = 0,
+  // A logged action was not legal (or attributed to the wrong player/round).
+  kIllegalAction = 1,
+  // The hand ended with different payoffs or terminal reason than logged.
+  kPayoffMismatch = 2,
+  // The logged actions ran out before the hand reached a terminal state.
+  kIncomplete = 3,
+};
+
+struct ReplayResult {
+  size_t index = 0;
+  uint64_t hand_id = 0;
+  ReplayStatus status = ReplayStatus::kOk;
+  int failed_action = -1;  // Position in the action list, kIllegalAction only.
+  std::array<int64_t, kNumPlayers> replayed_payoffs{};
+};
+
+struct ReplaySummary {
+  size_t hands = 0;
+  size_t ok = 0;
+  size_t illegal_action = 0;
+  size_t payoff_mismatch = 0;
+  size_t incomplete = 0;
+};
+
+struct ReplayOptions {
+  // Concurrent lanes on the shared pool; 0 uses the pool size.
+  int num_threads = 0;
+  // Deliver results to the sink in file order; otherwise in completion order.
+  bool ordered = true;
+  // Skip sink calls for hands that verified cleanly.
+  bool failures_only = false;
+  // Ordered mode only: decoded blocks allowed to wait behind the next block
+  // to emit before lanes stop claiming new ones; 0 uses four per lane.
+  int max_buffered_blocks = 0;
+};
+
+// Invoked at every decision point just before the logged action is applied.
+// Called concurrently from worker threads.
+using ReplayDecisionVisitor =
+    std::function<void(size_t index, const GameState& state,
+                       const ActionLogEntry& action)>;
+
+// Receives per-hand results. Calls are serialized.
+using ReplayResultSink = std::function<void(const ReplayResult& result)>;
+
+// Re-simulates one record on `state` (reset with the record's deck).
+ReplayResult ReplayHand(const HandRecord& record, size_t index,
+                        GameState* state,
+                        const ReplayDecisionVisitor& visitor = nullptr);
+
+// Replays every hand in `reader`, sharding blocks across worker threads.
+// Decode errors are rethrown on the calling thread after workers stop.
+ReplaySummary ReplayHistory(const HandHistoryReader& reader,
+                            const ReplayOptions& options,
+                            const ReplayResultSink& sink = nullptr,
+                            const ReplayDecisionVisitor& visitor = nullptr);
+
+}  // namespace pokerbot::core
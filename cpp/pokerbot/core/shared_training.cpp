@@ -0,0 +1,421 @@
+#include "shared_training.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace pokerbot::core {
+namespace {
+
+constexpr uint32_t kSegmentMagic = 0x53544250;     // "PBTS"
+constexpr uint32_t kCheckpointMagic = 0x4B434250;  // "PBCK"
+// Version 2 widened the table accumulators to double.
+constexpr uint32_t kSegmentVersion = 2;
+// The table starts one page into the segment.
+constexpr size_t kControlBytes = 4096;
+constexpr size_t kCheckpointPathBytes = 1024;
+// Longest single futex sleep, so deadlines and broken barriers are noticed.
+constexpr auto kWaitSlice = std::chrono::milliseconds(10);
+
+using Clock = std::chrono::steady_clock;
+
+std::string SegmentPath(const std::string& name) {
+  if (name.empty()) {
+    throw std::invalid_argument("Shared segment name must not be empty");
+  }
+  return name[0] == '/' ? name : "/" + name;
+}
+
+// Sleeps while `*word == expected`, for at most `slice`.
+void WaitWord(const std::atomic<uint32_t>* word, uint32_t expected,
+              std::chrono::nanoseconds slice) {
+#ifdef __linux__
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(slice);
+  timespec timeout{static_cast<time_t>(seconds.count()),
+                   static_cast<long>((slice - seconds).count())};
+  // Not FUTEX_PRIVATE: waiters live in different processes.
+  syscall(SYS_futex, reinterpret_cast<const uint32_t*>(word), FUTEX_WAIT,
+          expected, &timeout, nullptr, 0);
+#else
+  if (word->load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+        slice, std::chrono::microseconds(200)));
+  }
+#endif
+}
+
+void WakeAll(std::atomic<uint32_t>* word) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+// Waits until `*word != expected`. A non-positive timeout waits forever.
+bool WaitForChange(const std::atomic<uint32_t>* word, uint32_t expected,
+                   double timeout_ms,
+                   const std::atomic<uint32_t>* abort = nullptr) {
+  const bool bounded = timeout_ms > 0.0;
+  const auto deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double, std::milli>(timeout_ms));
+  while (word->load(std::memory_order_acquire) == expected) {
+    if (abort && abort->load(std::memory_order_acquire) != 0) {
+      return false;
+    }
+    std::chrono::nanoseconds slice = kWaitSlice;
+    if (bounded) {
+      const auto remaining = deadline - Clock::now();
+      if (remaining <= Clock::duration::zero()) {
+        return false;
+      }
+      slice = std::min<std::chrono::nanoseconds>(slice, remaining);
+    }
+    WaitWord(word, expected, slice);
+  }
+  return true;
+}
+
+struct CheckpointHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+  int64_t iteration;
+  uint64_t table_bytes;
+};
+
+}  // namespace
+
+struct SharedTrainingSegment::Control {
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint64_t capacity;
+  int32_t num_workers;
+
+  alignas(64) std::atomic<uint32_t> arrived;
+  std::atomic<uint32_t> generation;
+  std::atomic<uint32_t> broken;
+
+  alignas(64) std::atomic<int64_t> iteration;
+  std::atomic<int64_t> round_iterations;
+  std::atomic<uint32_t> stop_requested;
+  std::atomic<uint32_t> stopped;
+
+  // A requester claims the next ticket, writes the path, then publishes the
+  // ticket in checkpoint_requested. Claimed equals completed when idle.
+  alignas(64) std::atomic<uint32_t> checkpoint_claimed;
+  std::atomic<uint32_t> checkpoint_requested;
+  std::atomic<uint32_t> checkpoint_completed;
+  std::atomic<uint32_t> checkpoint_failed;
+  // Written only by the holder of the claimed ticket.
+  char checkpoint_path[kCheckpointPathBytes];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<int64_t>::is_always_lock_free,
+              "Cross-process control words must be lock-free");
+
+std::unique_ptr<SharedTrainingSegment> SharedTrainingSegment::Create(
+    const std::string& name, size_t capacity, int num_workers) {
+  static_assert(sizeof(Control) <= kControlBytes,
+                "Control block must fit before the table");
+  if (num_workers <= 0) {
+    throw std::invalid_argument("Shared training needs at least one worker");
+  }
+  const std::string path = SegmentPath(name);
+  capacity = RegretTable::RoundCapacity(capacity);
+  const size_t bytes = kControlBytes + RegretTable::BytesFor(capacity);
+
+  const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to create shared segment: " + path);
+  }
+  if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    throw std::runtime_error("Failed to size shared segment: " + path);
+  }
+  void* base =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    throw std::runtime_error("Failed to map shared segment: " + path);
+  }
+
+  // The segment starts zero-filled; construct the control words in place.
+  auto* control = new (base) Control();
+  control->version = kSegmentVersion;
+  control->capacity = capacity;
+  control->num_workers = num_workers;
+  std::unique_ptr<SharedTrainingSegment> segment(
+      new SharedTrainingSegment(path, true, base, bytes));
+  segment->table_ = std::make_unique<RegretTable>(
+      static_cast<unsigned char*>(base) + kControlBytes, capacity, true);
+  // Publish last so attachers never see a half-built segment.
+  control->magic.store(kSegmentMagic, std::memory_order_release);
+  return segment;
+}
+
+std::unique_ptr<SharedTrainingSegment> SharedTrainingSegment::Attach(
+    const std::string& name) {
+  const std::string path = SegmentPath(name);
+  const int fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open shared segment: " + path);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < kControlBytes) {
+    ::close(fd);
+    throw std::runtime_error("Shared segment is too small: " + path);
+  }
+  const size_t bytes = static_cast<size_t>(info.st_size);
+  void* base =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("Failed to map shared segment: " + path);
+  }
+  std::unique_ptr<SharedTrainingSegment> segment(
+      new SharedTrainingSegment(path, false, base, bytes));
+  const Control& control = *segment->control_;
+  if (control.magic.load(std::memory_order_acquire) != kSegmentMagic ||
+      control.version != kSegmentVersion) {
+    throw std::runtime_error("Not an initialized training segment: " + path);
+  }
+  if (bytes != kControlBytes + RegretTable::BytesFor(control.capacity)) {
+    throw std::runtime_error("Shared segment size mismatch: " + path);
+  }
+  segment->table_ = std::make_unique<RegretTable>(
+      static_cast<unsigned char*>(base) + kControlBytes, control.capacity,
+      false);
+  return segment;
+}
+
+SharedTrainingSegment::SharedTrainingSegment(std::string name, bool owner,
+                                             void* base, size_t bytes)
+    : name_(std::move(name)),
+      owner_(owner),
+      base_(base),
+      bytes_(bytes),
+      control_(static_cast<Control*>(base)) {}
+
+SharedTrainingSegment::~SharedTrainingSegment() {
+  table_.reset();
+  ::munmap(base_, bytes_);
+  if (owner_) {
+    ::shm_unlink(name_.c_str());
+  }
+}
+
+int SharedTrainingSegment::num_workers() const {
+  return control_->num_workers;
+}
+
+int64_t SharedTrainingSegment::iteration() const {
+  return control_->iteration.load(std::memory_order_acquire);
+}
+
+void SharedTrainingSegment::AddRoundIterations(int64_t iterations) {
+  control_->round_iterations.fetch_add(iterations, std::memory_order_relaxed);
+}
+
+bool SharedTrainingSegment::stopped() const {
+  return control_->stopped.load(std::memory_order_acquire) != 0;
+}
+
+BarrierResult SharedTrainingSegment::Barrier(
+    double timeout_ms, const std::function<void(int64_t, int64_t)>& serial) {
+  Control& control = *control_;
+  if (control.broken.load(std::memory_order_acquire) != 0) {
+    return BarrierResult::kTimeout;
+  }
+  const uint32_t generation =
+      control.generation.load(std::memory_order_acquire);
+  const uint32_t arrived =
+      control.arrived.fetch_add(1, std::memory_order_acq_rel) + 1;
+  if (arrived == static_cast<uint32_t>(control.num_workers)) {
+    std::exception_ptr error;
+    try {
+      RunSerialSection(serial);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    control.arrived.store(0, std::memory_order_relaxed);
+    control.generation.fetch_add(1, std::memory_order_release);
+    WakeAll(&control.generation);
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  } else if (!WaitForChange(&control.generation, generation, timeout_ms,
+                            &control.broken)) {
+    control.broken.store(1, std::memory_order_release);
+    WakeAll(&control.generation);
+    return BarrierResult::kTimeout;
+  }
+  return stopped() ? BarrierResult::kStopped : BarrierResult::kReleased;
+}
+
+void SharedTrainingSegment::RunSerialSection(
+    const std::function<void(int64_t, int64_t)>& serial) {
+  Control& control = *control_;
+  const int64_t before = control.iteration.load(std::memory_order_relaxed);
+  const int64_t after =
+      before + control.round_iterations.exchange(0, std::memory_order_relaxed);
+  control.iteration.store(after, std::memory_order_relaxed);
+  if (serial) {
+    serial(before, after);
+  }
+
+  const uint32_t requested =
+      control.checkpoint_requested.load(std::memory_order_acquire);
+  if (requested != control.checkpoint_completed.load(std::memory_order_relaxed)) {
+    uint32_t failed = 0;
+    try {
+      SaveCheckpoint(control.checkpoint_path);
+    } catch (...) {
+      failed = 1;
+    }
+    control.checkpoint_failed.store(failed, std::memory_order_relaxed);
+    control.checkpoint_completed.store(requested, std::memory_order_release);
+    WakeAll(&control.checkpoint_completed);
+  }
+
+  if (control.stop_requested.load(std::memory_order_acquire) != 0) {
+    control.stopped.store(1, std::memory_order_release);
+  }
+}
+
+void SharedTrainingSegment::RequestStop() {
+  control_->stop_requested.store(1, std::memory_order_release);
+}
+
+uint32_t SharedTrainingSegment::RequestCheckpoint(const std::string& path) {
+  if (path.empty() || path.size() >= kCheckpointPathBytes) {
+    throw std::invalid_argument("Checkpoint path is empty or too long");
+  }
+  Control& control = *control_;
+  uint32_t completed =
+      control.checkpoint_completed.load(std::memory_order_acquire);
+  uint32_t ticket;
+  // Only one concurrent requester, in any process, wins the claim and may
+  // write the path; the others see a pending request.
+  for (;;) {
+    ticket = completed + 1 == 0 ? 1 : completed + 1;
+    uint32_t claimed = completed;
+    if (control.checkpoint_claimed.compare_exchange_strong(
+            claimed, ticket, std::memory_order_acq_rel)) {
+      break;
+    }
+    const uint32_t now =
+        control.checkpoint_completed.load(std::memory_order_acquire);
+    if (claimed != now) {
+      return 0;
+    }
+    // A checkpoint completed since `completed` was read; claim again.
+    completed = now;
+  }
+  std::memcpy(control.checkpoint_path, path.c_str(), path.size() + 1);
+  control.checkpoint_requested.store(ticket, std::memory_order_release);
+  return ticket;
+}
+
+bool SharedTrainingSegment::WaitCheckpoint(uint32_t ticket,
+                                           double timeout_ms) const {
+  const Control& control = *control_;
+  uint32_t completed =
+      control.checkpoint_completed.load(std::memory_order_acquire);
+  while (completed != ticket) {
+    if (!WaitForChange(&control.checkpoint_completed, completed, timeout_ms)) {
+      return false;
+    }
+    completed = control.checkpoint_completed.load(std::memory_order_acquire);
+  }
+  if (control.checkpoint_failed.load(std::memory_order_relaxed) != 0) {
+    throw std::runtime_error("Failed to write checkpoint");
+  }
+  return true;
+}
+
+void SharedTrainingSegment::SaveCheckpoint(const std::string& path) const {
+  const CheckpointHeader header{kCheckpointMagic, kSegmentVersion,
+                                control_->capacity, iteration(),
+                                RegretTable::BytesFor(control_->capacity)};
+  // Write beside the target and rename so readers never see a torn file.
+  const std::string temp = path + ".tmp";
+  std::FILE* file = std::fopen(temp.c_str(), "wb");
+  if (!file) {
+    throw std::runtime_error("Failed to open checkpoint file: " + temp);
+  }
+  const bool written =
+      std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+      std::fwrite(table_->data(), 1, header.table_bytes, file) ==
+          header.table_bytes;
+  if (std::fclose(file) != 0 || !written ||
+      std::rename(temp.c_str(), path.c_str()) != 0) {
+    std::remove(temp.c_str());
+    throw std::runtime_error("Failed to write checkpoint file: " + path);
+  }
+}
+
+void SharedTrainingSegment::LoadCheckpoint(const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    throw std::runtime_error("Failed to open checkpoint file: " + path);
+  }
+  CheckpointHeader header{};
+  const bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                     header.magic == kCheckpointMagic &&
+                     header.version == kSegmentVersion &&
+                     header.capacity == control_->capacity &&
+                     header.table_bytes ==
+                         RegretTable::BytesFor(control_->capacity);
+  const bool read =
+      valid && std::fread(table_->data(), 1, header.table_bytes, file) ==
+                   header.table_bytes;
+  std::fclose(file);
+  if (!read) {
+    throw std::runtime_error("Checkpoint does not match this segment: " + path);
+  }
+  control_->iteration.store(header.iteration, std::memory_order_release);
+}
+
+BarrierResult RunSharedCfrRound(CfrTrainer& trainer,
+                                SharedTrainingSegment& segment,
+                                int64_t iterations, double timeout_ms) {
+  if (&trainer.table() != &segment.table() ||
+      !trainer.options().defer_discount) {
+    throw std::invalid_argument(
+        "Shared rounds need a deferred-discount trainer on the segment table");
+  }
+  if (segment.stopped()) {
+    return BarrierResult::kStopped;
+  }
+  trainer.set_iteration(segment.iteration());
+  trainer.RunIterations(iterations);
+  segment.AddRoundIterations(iterations);
+  return segment.Barrier(timeout_ms, [&](int64_t from, int64_t to) {
+    trainer.ApplyDiscountsBetween(from, to);
+  });
+}
+
+}  // namespace pokerbot::core
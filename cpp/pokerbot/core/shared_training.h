@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "cfr.h"
+#include "regret_table.h"
+
+namespace pokerbot::core {
+
+enum class BarrierResult : int {
+  kReleased = 0,
+  // The coordinator asked workers to stop; the round's updates are kept.
+  kStopped = 1,
+  // Not every participant arrived in time. The barrier stays broken, so
+  // all later calls fail too.
+  kTimeout = 2,
+};
+
+// Named POSIX shared-memory segment holding a RegretTable plus a small
+// control block through which one coordinator and `num_workers` worker
+// processes on the same host synchronize. The coordinator creates (and on
+// destruction unlinks) the segment; workers attach to it by name.
+//
+// Workers train in rounds separated by Barrier(). The last worker to arrive
+// runs the round's serial section while the others wait, so the table is
+// quiescent there: it folds the round's iterations into the global count,
+// runs the caller's hook (e.g. discounting), writes a requested checkpoint
+// and publishes a requested stop. Waiting uses futexes on Linux.
+class SharedTrainingSegment {
+ public:
+  static std::unique_ptr<SharedTrainingSegment> Create(const std::string& name,
+                                                       size_t capacity,
+                                                       int num_workers);
+  static std::unique_ptr<SharedTrainingSegment> Attach(const std::string& name);
+  ~SharedTrainingSegment();
+
+  SharedTrainingSegment(const SharedTrainingSegment&) = delete;
+  SharedTrainingSegment& operator=(const SharedTrainingSegment&) = delete;
+
+  const std::string& name() const { return name_; }
+  bool is_owner() const { return owner_; }
+  int num_workers() const;
+  RegretTable& table() { return *table_; }
+
+  // Iterations completed by all workers as of the last barrier. Stable
+  // between barriers.
+  int64_t iteration() const;
+  // Counts iterations this worker ran in the current round.
+  void AddRoundIterations(int64_t iterations);
+  // True once a stop request has been published by a barrier.
+  bool stopped() const;
+
+  // Blocks until all workers arrive. `serial` runs on the last arriver with
+  // the global iteration count before and after the round.
+  BarrierResult Barrier(
+      double timeout_ms,
+      const std::function<void(int64_t, int64_t)>& serial = nullptr);
+
+  // Coordinator controls; may be called from any attached process.
+  void RequestStop();
+  // Asks the next barrier to write a checkpoint to `path`. Returns the
+  // request's ticket, or 0 while an earlier request is still pending.
+  uint32_t RequestCheckpoint(const std::string& path);
+  // Waits for checkpoint `ticket`. Returns false on timeout; throws
+  // std::runtime_error if the checkpoint could not be written.
+  bool WaitCheckpoint(uint32_t ticket, double timeout_ms) const;
+
+  // Checkpoint file: the table block plus the iteration count. Loading
+  // requires a matching capacity and must happen before workers start.
+  void SaveCheckpoint(const std::string& path) const;
+  void LoadCheckpoint(const std::string& path);
+
+ private:
+  struct Control;
+
+  SharedTrainingSegment(std::string name, bool owner, void* base,
+                        size_t bytes);
+
+  void RunSerialSection(
+      const std::function<void(int64_t, int64_t)>& serial);
+
+  std::string name_;
+  bool owner_ = false;
+  void* base_ = nullptr;
+  size_t bytes_ = 0;
+  Control* control_ = nullptr;
+  std::unique_ptr<RegretTable> table_;
+};
+
+// One training round for a worker process: runs `iterations` iterations of
+// `trainer` (which must train into segment.table() with defer_discount set)
+// from the current global iteration, then waits at the barrier. The last
+// arriver applies the round's discounts once for everyone.
+BarrierResult RunSharedCfrRound(CfrTrainer& trainer,
+                                SharedTrainingSegment& segment,
+                                int64_t iterations, double timeout_ms);
+
+}  // namespace pokerbot::core
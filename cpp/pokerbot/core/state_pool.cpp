@@ -0,0 +1,102 @@
+#include "state_pool.h"
+
+#include <new>
+#include <stdexcept>
+
+namespace pokerbot::core {
+namespace {
+
+constexpr uint64_t kIndexMask = 0xFFFFFFFFull;
+
+}  // namespace
+
+GameStatePool::GameStatePool(size_t capacity, GameConfig config)
+    : capacity_(capacity) {
+  if (capacity == 0 || capacity > kIndexMask) {
+    throw std::invalid_argument("GameStatePool capacity out of range");
+  }
+  void* storage = ::operator new(sizeof(Slot) * capacity,
+                                 std::align_val_t{alignof(Slot)});
+  slots_ = static_cast<Slot*>(storage);
+  for (size_t i = 0; i < capacity; ++i) {
+    new (&slots_[i]) Slot(config);
+  }
+  free_list_.reserve(capacity);
+  for (size_t i = capacity; i > 0; --i) {
+    free_list_.push_back(static_cast<uint32_t>(i - 1));
+  }
+}
+
+GameStatePool::~GameStatePool() {
+  for (size_t i = 0; i < capacity_; ++i) {
+    slots_[i].~Slot();
+  }
+  ::operator delete(slots_, std::align_val_t{alignof(Slot)});
+}
+
+size_t GameStatePool::in_use() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_ - free_list_.size();
+}
+
+bool GameStatePool::Acquire(size_t count, Handle* out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count > free_list_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t index = free_list_.back();
+    free_list_.pop_back();
+    const uint32_t generation =
+        slots_[index].generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+    out[i] = (static_cast<uint64_t>(generation) << 32) | index;
+  }
+  return true;
+}
+
+size_t GameStatePool::Release(const Handle* handles, size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t released = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const Handle handle = handles[i];
+    const uint64_t index = handle & kIndexMask;
+    if (index >= capacity_) {
+      continue;
+    }
+    uint32_t expected = static_cast<uint32_t>(handle >> 32);
+    if ((expected & 1u) == 0 ||
+        !slots_[index].generation.compare_exchange_strong(
+            expected, expected + 1, std::memory_order_acq_rel)) {
+      continue;
+    }
+    free_list_.push_back(static_cast<uint32_t>(index));
+    ++released;
+  }
+  return released;
+}
+
+const GameStatePool::Slot* GameStatePool::Lookup(Handle handle) const {
+  const uint64_t index = handle & kIndexMask;
+  if (index >= capacity_) {
+    return nullptr;
+  }
+  const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+  const Slot& slot = slots_[index];
+  if ((generation & 1u) == 0 ||
+      slot.generation.load(std::memory_order_acquire) != generation) {
+    return nullptr;
+  }
+  return &slot;
+}
+
+GameState* GameStatePool::Get(Handle handle) {
+  const Slot* slot = Lookup(handle);
+  return slot ? &slots_[slot - slots_].state : nullptr;
+}
+
+const GameState* GameStatePool::Get(Handle handle) const {
+  const Slot* slot = Lookup(handle);
+  return slot ? &slot->state : nullptr;
+}
+
+}  // namespace pokerbot::core
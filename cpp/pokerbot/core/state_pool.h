@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "limit_holdem_game.h"
+
+namespace pokerbot::core {
+
+// Fixed arena of preconstructed game states addressed by integer handles.
+// Each state sits in its own cache-line aligned slot so workers touching
+// neighbouring handles do not share lines. Acquire/Release are thread-safe;
+// a single handle must not be used from two threads at once.
+class GameStatePool {
+ public:
+  // Low 32 bits: slot index. High 32 bits: slot generation (odd while the
+  // slot is acquired), so released handles are rejected.
+  using Handle = uint64_t;
+
+  explicit GameStatePool(size_t capacity, GameConfig config = GameConfig());
+  ~GameStatePool();
+
+  GameStatePool(const GameStatePool&) = delete;
+  GameStatePool& operator=(const GameStatePool&) = delete;
+
+  size_t capacity() const { return capacity_; }
+  size_t in_use() const;
+
+  // All-or-nothing: returns false and acquires nothing if fewer than `count`
+  // slots are free.
+  bool Acquire(size_t count, Handle* out);
+
+  // Returns the number of handles released; invalid handles are skipped.
+  size_t Release(const Handle* handles, size_t count);
+
+  // Returns nullptr for stale or malformed handles.
+  GameState* Get(Handle handle);
+  const GameState* Get(Handle handle) const;
+
+ private:
+  struct alignas(64) Slot {
+    explicit Slot(const GameConfig& config) : state(config) {}
+
+    GameState state;
+    std::atomic<uint32_t> generation{0};
+  };
+
+  const Slot* Lookup(Handle handle) const;
+
+  size_t capacity_ = 0;
+  Slot* slots_ = nullptr;  // One contiguous, cache-line aligned block.
+  mutable std::mutex mutex_;
+  std::vector<uint32_t> free_list_;
+};
+
+}  // namespace pokerbot::core
@@ -0,0 +1,373 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pokerbot::core {
+namespace {
+
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local int tls_worker = -1;
+
+int ResolveThreadCount(int requested) {
+  if (requested > 0) {
+    return requested;
+  }
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+#ifdef __linux__
+// Parses a sysfs CPU list such as "0-3,8-11".
+std::vector<int> ParseCpuList(const std::string& text) {
+  std::vector<int> cpus;
+  std::stringstream stream(text);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    const size_t dash = range.find('-');
+    try {
+      const int lo = std::stoi(range.substr(0, dash));
+      const int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+      for (int cpu = lo; cpu <= hi; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (...) {
+      return {};
+    }
+  }
+  return cpus;
+}
+
+// CPUs this process may run on, grouped by NUMA node (one group when the
+// topology is unavailable).
+std::vector<std::vector<int>> CpuGroups(bool by_node) {
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return {};
+  }
+  std::vector<std::vector<int>> groups;
+  if (by_node) {
+    for (int node = 0;; ++node) {
+      std::ifstream file("/sys/devices/system/node/node" +
+                         std::to_string(node) + "/cpulist");
+      if (!file) {
+        break;
+      }
+      std::string text;
+      std::getline(file, text);
+      std::vector<int> group;
+      for (int cpu : ParseCpuList(text)) {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+          group.push_back(cpu);
+        }
+      }
+      if (!group.empty()) {
+        groups.push_back(std::move(group));
+      }
+    }
+  }
+  if (groups.empty()) {
+    std::vector<int> group;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        group.push_back(cpu);
+      }
+    }
+    if (!group.empty()) {
+      groups.push_back(std::move(group));
+    }
+  }
+  return groups;
+}
+
+// CPU set for worker `index`; empty means "do not touch affinity".
+std::vector<int> PlacementFor(const ThreadPoolOptions& options,
+                              const std::vector<std::vector<int>>& groups,
+                              int index) {
+  if (groups.empty() ||
+      (!options.pin_threads && options.numa_policy == NumaPolicy::kNone)) {
+    return {};
+  }
+  size_t group = 0;
+  size_t slot = 0;
+  if (options.numa_policy == NumaPolicy::kSpread) {
+    group = index % groups.size();
+    slot = (index / groups.size()) % groups[group].size();
+  } else {
+    size_t total = 0;
+    for (const auto& cpus : groups) {
+      total += cpus.size();
+    }
+    size_t flat = index % total;
+    while (flat >= groups[group].size()) {
+      flat -= groups[group].size();
+      ++group;
+    }
+    slot = flat;
+  }
+  if (options.pin_threads) {
+    return {groups[group][slot]};
+  }
+  return groups[group];
+}
+
+void ApplyAffinity(std::thread& thread, const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  // Best effort: placement is an optimization, not a requirement.
+  pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+#endif
+
+std::mutex& DefaultPoolMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::shared_ptr<ThreadPool>& DefaultPoolSlot() {
+  static std::shared_ptr<ThreadPool> pool;
+  return pool;
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(ThreadPoolOptions options) : options_(options) {
+  const int total = ResolveThreadCount(options_.num_threads);
+  options_.num_threads = total;
+  const int worker_count = total - 1;
+  for (int i = 0; i < worker_count; ++i) {
+    queues_.push_back(std::make_unique<Worker>());
+  }
+#ifdef __linux__
+  const auto groups = CpuGroups(options_.numa_policy != NumaPolicy::kNone);
+#endif
+  workers_.reserve(worker_count);
+  for (int i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+#ifdef __linux__
+    ApplyAffinity(workers_.back(), PlacementFor(options_, groups, i));
+#endif
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+uint64_t ThreadPool::TaskSeed(uint64_t base_seed, uint64_t index) {
+  uint64_t z = base_seed + 0x9E3779B97F4A7C15ull * (index + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+void ThreadPool::Push(std::function<void()> task) {
+  const size_t target =
+      (tls_pool == this && tls_worker >= 0)
+          ? static_cast<size_t>(tls_worker)
+          : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_cv_.notify_one();
+}
+
+bool ThreadPool::TryRunOne(int self) {
+  std::function<void()> task;
+  {
+    Worker& own = *queues_[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+    }
+  }
+  if (!task) {
+    const size_t count = queues_.size();
+    const size_t start = static_cast<size_t>(self) + 1;
+    for (size_t k = 0; k < count && !task; ++k) {
+      Worker& victim = *queues_[(start + k) % count];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+      }
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  queued_.fetch_sub(1, std::memory_order_acq_rel);
+  task();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(int index) {
+  tls_pool = this;
+  tls_worker = index;
+  for (;;) {
+    if (TryRunOne(index)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] {
+      return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+// One ParallelFor call. Helper tasks hold a reference, so a helper that
+// starts after the caller has returned finds no chunks left and exits
+// without touching `body`.
+struct ThreadPool::ParallelBatch {
+  const std::function<void(size_t, size_t)>* body = nullptr;
+  size_t begin = 0;
+  size_t end = 0;
+  size_t grain = 1;
+  size_t chunks = 0;
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> failed{false};
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t completed = 0;
+  std::exception_ptr error;
+
+  // Claims and runs chunks until none are left.
+  void RunChunks() {
+    size_t ran = 0;
+    std::exception_ptr first_error;
+    for (;;) {
+      const size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunks) {
+        break;
+      }
+      ++ran;
+      if (failed.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      const size_t lo = begin + chunk * grain;
+      try {
+        (*body)(lo, std::min(end, lo + grain));
+      } catch (...) {
+        if (!first_error) {
+          first_error = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+    if (ran == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (first_error && !error) {
+      error = first_error;
+    }
+    completed += ran;
+    // Notify under the lock: the caller may return as soon as it sees the
+    // count, and the batch must not be released mid-notify.
+    if (completed == chunks) {
+      finished.notify_all();
+    }
+  }
+};
+
+void ThreadPool::ParallelFor(size_t begin, size_t end, size_t grain,
+                             const std::function<void(size_t, size_t)>& body) {
+  if (end <= begin) {
+    return;
+  }
+  grain = grain == 0 ? 1 : grain;
+  const size_t chunks = (end - begin + grain - 1) / grain;
+  if (workers_.empty() || chunks == 1) {
+    for (size_t lo = begin; lo < end; lo += grain) {
+      body(lo, std::min(end, lo + grain));
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<ParallelBatch>();
+  batch->body = &body;
+  batch->begin = begin;
+  batch->end = end;
+  batch->grain = grain;
+  batch->chunks = chunks;
+  // The caller takes chunks too, so one helper per remaining chunk at most.
+  const size_t helpers = std::min(chunks - 1, workers_.size());
+  for (size_t i = 0; i < helpers; ++i) {
+    Push([batch] { batch->RunChunks(); });
+  }
+
+  // Help only with this batch, then sleep until chunks claimed by helpers
+  // finish. Those are already running, so blocking cannot deadlock nested
+  // calls, and the caller never picks up unrelated tasks.
+  batch->RunChunks();
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->finished.wait(lock, [&] { return batch->completed == chunks; });
+  if (batch->error) {
+    std::rethrow_exception(batch->error);
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  Push(std::move(task));
+}
+
+std::shared_ptr<ThreadPool> DefaultThreadPool() {
+  std::lock_guard<std::mutex> lock(DefaultPoolMutex());
+  std::shared_ptr<ThreadPool>& pool = DefaultPoolSlot();
+  if (!pool) {
+    pool = std::make_shared<ThreadPool>();
+  }
+  return pool;
+}
+
+void ConfigureDefaultThreadPool(const ThreadPoolOptions& options) {
+  auto replacement = std::make_shared<ThreadPool>(options);
+  std::shared_ptr<ThreadPool> previous;
+  {
+    std::lock_guard<std::mutex> lock(DefaultPoolMutex());
+    previous = std::move(DefaultPoolSlot());
+    DefaultPoolSlot() = std::move(replacement);
+  }
+  // `previous` joins its workers here unless someone still holds it.
+}
+
+}  // namespace pokerbot::core
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pokerbot::core {
+
+enum class NumaPolicy : int {
+  // Leave placement to the OS scheduler.
+  kNone = 0,
+  // Fill one NUMA node's CPUs before moving to the next.
+  kCompact = 1,
+  // Round-robin workers across NUMA nodes.
+  kSpread = 2,
+};
+
+struct ThreadPoolOptions {
+  // Total concurrency including the calling thread, which runs chunks of its
+  // own ParallelFor. 0 uses std::thread::hardware_concurrency().
+  int num_threads = 0;
+  // Pin each worker to one CPU (Linux only; ignored elsewhere).
+  bool pin_threads = false;
+  NumaPolicy numa_policy = NumaPolicy::kNone;
+};
+
+// Work-stealing scheduler shared by the library's parallel workloads. Each
+// worker owns a deque: it pops its own newest task and steals the oldest
+// task from others when empty. A ParallelFor caller (including a nested call
+// from inside a task) runs chunks of its own loop, then blocks until the
+// chunks taken by helpers finish; it never runs unrelated queued tasks.
+class ThreadPool {
+ public:
+  explicit ThreadPool(ThreadPoolOptions options = ThreadPoolOptions());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Total concurrency: worker threads plus the calling thread.
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+  const ThreadPoolOptions& options() const { return options_; }
+
+  // Splits [begin, end) into chunks of at most `grain` indices and runs
+  // body(chunk_begin, chunk_end) for each. Returns when all chunks finish;
+  // the first exception thrown by a chunk is rethrown here.
+  void ParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)>& body);
+
+  // Queues `task` to run asynchronously on a worker, or runs it inline when
+  // the pool has no worker threads. The task must not throw; completion is
+  // the caller's to track.
+  void Submit(std::function<void()> task);
+
+  // Maps each chunk to a value and folds the chunk results in index order,
+  // so the result does not depend on scheduling.
+  template <typename T, typename Map, typename Combine>
+  T ParallelReduce(size_t begin, size_t end, size_t grain, T identity,
+                   Map map, Combine combine) {
+    if (end <= begin) {
+      return identity;
+    }
+    grain = grain == 0 ? 1 : grain;
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    std::vector<T> partial(chunks, identity);
+    ParallelFor(0, chunks, 1, [&](size_t chunk, size_t) {
+      const size_t lo = begin + chunk * grain;
+      const size_t hi = lo + grain < end ? lo + grain : end;
+      partial[chunk] = map(lo, hi);
+    });
+    T result = identity;
+    for (T& value : partial) {
+      result = combine(std::move(result), std::move(value));
+    }
+    return result;
+  }
+
+  // Seed for task `index` of a job seeded with `base_seed`, suitable for
+  // GameState::Reset. Depends only on the pair, never on thread count or
+  // chunking, so parallel runs are reproducible.
+  static uint64_t TaskSeed(uint64_t base_seed, uint64_t index);
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+  struct ParallelBatch;
+
+  void Push(std::function<void()> task);
+  // Runs one task from worker `self`'s deque, or one stolen from another.
+  bool TryRunOne(int self);
+  void WorkerLoop(int index);
+
+  ThreadPoolOptions options_;
+  std::vector<std::unique_ptr<Worker>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> next_queue_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stopping_ = false;
+};
+
+// Process-wide pool used by replay, search and other parallel features.
+// Holders keep the pool alive across a reconfiguration.
+std::shared_ptr<ThreadPool> DefaultThreadPool();
+
+// Replaces the process-wide pool. Work already running on the old pool
+// finishes there.
+void ConfigureDefaultThreadPool(const ThreadPoolOptions& options);
+
+}  // namespace pokerbot::core
@@ -0,0 +1,35 @@
+"""Native hand evaluation for 5 to 7 cards."""
+
+from __future__ import annotations
+
+import ctypes
+from typing import Sequence
+
+from .native import load_library
+
+__all__ = ["evaluate_best_hand", "evaluate_with_board"]
+
+
+def evaluate_best_hand(cards: Sequence[int]) -> int:
+  """Value of the strongest 5-card hand in `cards`; higher is better."""
+  if not 5 <= len(cards) <= 7:
+    raise ValueError("Expected 5 to 7 cards")
+  buffer = (ctypes.c_uint8 * len(cards))(*cards)
+  value = load_library().pokerbot_evaluate_best_hand(buffer, len(cards))
+  if value == 0:
+    raise ValueError(f"Invalid cards {list(cards)}")
+  return int(value)
+
+
+def evaluate_with_board(hole_cards: Sequence[int],
+                        board: Sequence[int]) -> int:
+  """Same scale as evaluate_best_hand(), via the incremental evaluator."""
+  if len(hole_cards) != 2 or not 3 <= len(board) <= 5:
+    raise ValueError("Expected two hole cards and 3 to 5 board cards")
+  hole = (ctypes.c_uint8 * 2)(*hole_cards)
+  board_buffer = (ctypes.c_uint8 * len(board))(*board)
+  value = load_library().pokerbot_evaluate_with_board(hole, board_buffer,
+                                                      len(board))
+  if value == 0:
+    raise ValueError(f"Invalid cards {list(hole_cards)} {list(board)}")
+  return int(value)
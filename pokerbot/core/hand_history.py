@@ -0,0 +1,301 @@
+"""Python access to the native binary hand-history log."""
+
+from __future__ import annotations
+
+import ctypes
+import os
+import threading
+from dataclasses import dataclass, field
+from enum import IntEnum
+from typing import Callable, Iterator, List, Optional, Union
+
+from .limit_holdem import ActionType, LimitHoldemState
+from .native import (HistoryRecordCallback, ReplayDecisionCallback,
+                     ReplayOptions, ReplayResultCallback, load_library)
+
+__all__ = [
+    "HandRecord",
+    "HandHistoryWriter",
+    "HandHistoryReader",
+    "ReplayResult",
+    "ReplayStatus",
+    "ReplaySummary",
+    "replay_history",
+]
+
+# Limit Hold'em caps a hand well below this many actions.
+_MAX_ACTIONS = 64
+
+PathLike = Union[str, "os.PathLike[str]"]
+
+
+@dataclass
+class HandRecord:
+  hand_id: int
+  deck: List[int]
+  actions: List[ActionType] = field(default_factory=list)
+  payoffs: List[int] = field(default_factory=list)
+
+
+class ReplayStatus(IntEnum):
+  OK = 0
+  ILLEGAL_ACTION = 1
+  PAYOFF_MISMATCH = 2
+  INCOMPLETE = 3
+
+
+@dataclass
+class ReplayResult:
+  index: int
+  hand_id: int
+  status: ReplayStatus
+  failed_action: int
+  replayed_payoffs: List[int]
+
+
+@dataclass
+class ReplaySummary:
+  hands: int
+  ok: int
+  illegal_action: int
+  payoff_mismatch: int
+  incomplete: int
+  failed_indices: List[int] = field(default_factory=list)
+
+
+def _make_record(hand_id: int, deck, payoffs, actions,
+                 count: int) -> HandRecord:
+  return HandRecord(
+      hand_id=int(hand_id),
+      deck=list(deck[:52]),
+      actions=[ActionType(actions[i]) for i in range(count)],
+      payoffs=[int(payoffs[0]), int(payoffs[1])],
+  )
+
+
+class HandHistoryWriter:
+  """Append-only writer; records are flushed by a native background thread."""
+
+  def __init__(self, path: PathLike, block_bytes: int = 0,
+               store_full_deck: bool = False) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_history_writer_open(
+        os.fsencode(path), int(block_bytes), int(store_full_deck))
+    if not ptr:
+      raise RuntimeError(f"Failed to open hand history for writing: {path}")
+    self._ptr = ctypes.c_void_p(ptr)
+
+  def append(self, state: LimitHoldemState, hand_id: int) -> None:
+    ok = self._lib.pokerbot_history_writer_append_state(
+        self._ptr, state._holder.ptr, ctypes.c_uint64(hand_id))
+    if not ok:
+      raise RuntimeError("Failed to append hand to history")
+
+  def flush(self) -> None:
+    if not self._lib.pokerbot_history_writer_flush(self._ptr):
+      raise RuntimeError("Failed to flush hand history")
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      ok = self._lib.pokerbot_history_writer_close(self._ptr)
+      self._ptr = None
+      if not ok:
+        raise RuntimeError("Failed to close hand history")
+
+  def __enter__(self) -> "HandHistoryWriter":
+    return self
+
+  def __exit__(self, *exc) -> None:
+    self.close()
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+
+class HandHistoryReader:
+  """Random-access reader over a memory-mapped hand history file."""
+
+  def __init__(self, path: PathLike) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_history_reader_open(os.fsencode(path))
+    if not ptr:
+      raise RuntimeError(f"Failed to open hand history for reading: {path}")
+    self._ptr = ctypes.c_void_p(ptr)
+
+  def __len__(self) -> int:
+    return int(self._lib.pokerbot_history_reader_size(self._ptr))
+
+  def read(self, index: int) -> HandRecord:
+    hand_id = ctypes.c_uint64()
+    deck = (ctypes.c_uint8 * 52)()
+    payoffs = (ctypes.c_int64 * 2)()
+    actions = (ctypes.c_int * _MAX_ACTIONS)()
+    count = self._lib.pokerbot_history_reader_read(
+        self._ptr, int(index), ctypes.byref(hand_id), deck, payoffs, actions,
+        _MAX_ACTIONS)
+    if count < 0:
+      raise IndexError(f"Failed to read hand history record {index}")
+    return _make_record(hand_id.value, deck, payoffs, actions,
+                        min(count, _MAX_ACTIONS))
+
+  def __iter__(self) -> Iterator[HandRecord]:
+    """Yields records in file order, decoding each block only once."""
+    cursor = self._lib.pokerbot_history_cursor_open(self._ptr, 0)
+    if not cursor:
+      raise RuntimeError("Failed to open hand history cursor")
+    cursor = ctypes.c_void_p(cursor)
+    hand_id = ctypes.c_uint64()
+    deck = (ctypes.c_uint8 * 52)()
+    payoffs = (ctypes.c_int64 * 2)()
+    actions = (ctypes.c_int * _MAX_ACTIONS)()
+    try:
+      while True:
+        count = self._lib.pokerbot_history_cursor_next(
+            cursor, ctypes.byref(hand_id), deck, payoffs, actions,
+            _MAX_ACTIONS)
+        if count == -1:
+          return
+        if count < 0:
+          raise RuntimeError("Corrupt hand history block")
+        yield _make_record(hand_id.value, deck, payoffs, actions,
+                           min(count, _MAX_ACTIONS))
+    finally:
+      self._lib.pokerbot_history_cursor_close(cursor)
+
+  def for_each(self, visitor: Callable[[HandRecord], Optional[bool]],
+               predicate: Optional[Callable[[HandRecord], bool]] = None
+               ) -> int:
+    """Scans natively, visiting the records `predicate` accepts.
+
+    A visitor returning False stops the scan. Returns the number visited.
+    """
+    errors: List[BaseException] = []
+
+    def _wrap(fn, stop_on_false):
+      def _call(hand_id, deck, payoffs, actions, count, _):
+        if errors:
+          # Accept in the predicate so the visitor can stop the scan.
+          return 1
+        try:
+          result = fn(_make_record(hand_id, deck, payoffs, actions, count))
+        except BaseException as exc:  # Re-raised once the scan unwinds.
+          errors.append(exc)
+          return 1
+        if stop_on_false:
+          return 1 if result is False else 0
+        return 1 if result else 0
+      return HistoryRecordCallback(_call)
+
+    visit = _wrap(visitor, True)
+    accept = _wrap(predicate, False) if predicate else HistoryRecordCallback()
+    visited = self._lib.pokerbot_history_reader_for_each(
+        self._ptr, accept, visit, None)
+    if errors:
+      raise errors[0]
+    if visited < 0:
+      raise RuntimeError("Corrupt hand history block")
+    return int(visited)
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      self._lib.pokerbot_history_reader_close(self._ptr)
+      self._ptr = None
+
+  def __enter__(self) -> "HandHistoryReader":
+    return self
+
+  def __exit__(self, *exc) -> None:
+    self.close()
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+
+def replay_history(
+    path: PathLike,
+    num_threads: int = 0,
+    max_failures: int = 1024,
+    *,
+    ordered: bool = True,
+    failures_only: bool = True,
+    max_buffered_blocks: int = 0,
+    on_result: Optional[Callable[[ReplayResult], None]] = None,
+    on_decision: Optional[Callable[[int, LimitHoldemState, ActionType],
+                                   None]] = None,
+) -> ReplaySummary:
+  """Re-simulates every logged hand natively and verifies its payoffs.
+
+  `on_result` receives every hand (only failing ones when `failures_only`),
+  in file order when `ordered`, where `max_buffered_blocks` (0 = four per
+  thread) bounds the results held back by a slow block.
+  `on_decision(index, state, action)` sees each decision before its logged
+  action is applied; it runs on native worker threads and `state` is only
+  valid during the call. An exception from either callback stops the replay
+  and is re-raised here.
+  """
+  lib = load_library()
+  options = ReplayOptions(num_threads=int(num_threads),
+                          ordered=1 if ordered else 0,
+                          failures_only=1 if failures_only else 0,
+                          max_buffered_blocks=int(max_buffered_blocks))
+  snapshot_size = lib.pokerbot_snapshot_size()
+  failed_indices: List[int] = []
+  errors: List[BaseException] = []
+  scratch = threading.local()
+
+  def _result(index, hand_id, status, failed_action, payoffs, _):
+    try:
+      result = ReplayResult(index=int(index), hand_id=int(hand_id),
+                            status=ReplayStatus(status),
+                            failed_action=int(failed_action),
+                            replayed_payoffs=[int(payoffs[0]),
+                                              int(payoffs[1])])
+      if (result.status != ReplayStatus.OK and
+          len(failed_indices) < max_failures):
+        failed_indices.append(result.index)
+      if on_result is not None:
+        on_result(result)
+      return 0
+    except BaseException as exc:  # Re-raised once the replay unwinds.
+      errors.append(exc)
+      return 1
+
+  def _decision(index, snapshot, action, _):
+    try:
+      state = getattr(scratch, "state", None)
+      if state is None:
+        state = scratch.state = LimitHoldemState(seed=0)
+      state.restore(ctypes.string_at(snapshot, snapshot_size))
+      on_decision(int(index), state, ActionType(action))
+      return 0
+    except BaseException as exc:
+      errors.append(exc)
+      return 1
+
+  result_callback = ReplayResultCallback(_result)
+  decision_callback = (ReplayDecisionCallback(_decision)
+                       if on_decision is not None else
+                       ReplayDecisionCallback())
+  summary = (ctypes.c_int64 * 5)()
+  status = lib.pokerbot_replay_run(os.fsencode(path), ctypes.byref(options),
+                                   result_callback, decision_callback, None,
+                                   summary)
+  if errors:
+    raise errors[0]
+  if status != 0:
+    raise RuntimeError(
+        f"Failed to replay hand history: {path} (status {status})")
+  return ReplaySummary(
+      hands=int(summary[0]),
+      ok=int(summary[1]),
+      illegal_action=int(summary[2]),
+      payoff_mismatch=int(summary[3]),
+      incomplete=int(summary[4]),
+      failed_indices=failed_indices,
+  )
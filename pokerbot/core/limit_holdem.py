@@ -6,19 +6,11 @@ import random
 from enum import IntEnum
 from typing import Iterable, List, Optional, Sequence
 
-from .native import NativeGameStateHolder, load_library
+from .native import ActionType, NativeGameStateHolder, load_library
 
 __all__ = ["ActionType", "TerminalReason", "LimitHoldemState"]
 
 
-class ActionType(IntEnum):
-  FOLD = 0
-  CHECK = 1
-  CALL = 2
-  BET = 3
-  RAISE = 4
-
-
 class TerminalReason(IntEnum):
   NONE = 0
   FOLD = 1
@@ -43,12 +35,23 @@ class LimitHoldemState:
     self._holder.reset(seed)
 
   def reset_with_deck(self, deck: Sequence[int]) -> None:
-    """Deterministic reset with a predefined deck ordering."""
+    """Deterministic reset with a predefined deck ordering.
+
+    Raises ValueError if the first 52 cards are not a permutation of 0..51.
+    """
     self._holder.reset_with_deck(deck)
 
   def close(self) -> None:
     self._holder.close()
 
+  def snapshot(self) -> bytes:
+    """Packs the hand into a fixed-size blob for cheap cloning."""
+    return self._holder.snapshot()
+
+  def restore(self, snapshot: bytes) -> None:
+    """Resumes the hand captured by snapshot()."""
+    self._holder.restore(snapshot)
+
   # --------------------------------------------------------------------------- #
   # State queries
   # --------------------------------------------------------------------------- #
@@ -105,6 +108,14 @@ class LimitHoldemState:
   def payoffs(self) -> List[int]:
     return self._holder.payoffs()
 
+  def hand_strength(self, player: int) -> int:
+    """Comparable value of the player's best hand with the exposed board."""
+    return int(
+        self._holder.lib.pokerbot_state_hand_strength(
+            self._holder.ptr, int(player)
+        )
+    )
+
   # --------------------------------------------------------------------------- #
   # Actions
   # --------------------------------------------------------------------------- #
@@ -5,10 +5,29 @@ from __future__ import annotations
 import ctypes
 import os
 import sys
+from enum import IntEnum
 from pathlib import Path
 from typing import Iterable, List, Optional, Sequence
 
-__all__ = ["load_library", "NativeGameStateHolder", "ActionType"]
+__all__ = [
+    "load_library",
+    "ActionType",
+    "CfrOptions",
+    "BatchPolicyCallback",
+    "HandSinkCallback",
+    "HistoryRecordCallback",
+    "NativeGameStateHolder",
+    "RangeCallback",
+    "RangeSumCallback",
+    "ReplayDecisionCallback",
+    "ReplayOptions",
+    "ReplayResultCallback",
+    "SchedulerOptions",
+    "StateInfo",
+    "Status",
+    "restore_states",
+    "snapshot_states",
+]
 
 
 def _library_name() -> str:
@@ -48,6 +67,155 @@ def _candidate_library_paths(lib_name: str) -> List[Path]:
   return unique_candidates
 
 
+class ActionType(IntEnum):
+  """Mirror of PokerbotAction."""
+
+  FOLD = 0
+  CHECK = 1
+  CALL = 2
+  BET = 3
+  RAISE = 4
+
+
+class Status(IntEnum):
+  """Mirror of PokerbotStatus, returned by most native calls."""
+
+  OK = 0
+  INVALID_ARGUMENT = 1
+  INVALID_HANDLE = 2
+  POOL_EXHAUSTED = 3
+  ILLEGAL_ACTION = 4
+  INTERNAL = 5
+  TIMEOUT = 6
+  IO = 7
+  STOPPED = 8
+  EMPTY_RANGE = 9
+
+
+class StateInfo(ctypes.Structure):
+  """Mirror of PokerbotStateInfo."""
+
+  _fields_ = [
+      ("current_player", ctypes.c_int32),
+      ("betting_round", ctypes.c_int32),
+      ("is_terminal", ctypes.c_int32),
+      ("terminal_reason", ctypes.c_int32),
+      ("winner", ctypes.c_int32),
+      ("board_count", ctypes.c_int32),
+      ("legal_action_mask", ctypes.c_uint32),
+      ("reserved", ctypes.c_int32),
+      ("pot", ctypes.c_int64),
+      ("to_call", ctypes.c_int64),
+      ("payoffs", ctypes.c_int64 * 2),
+  ]
+
+
+class CfrOptions(ctypes.Structure):
+  """Mirror of PokerbotCfrOptions."""
+
+  _fields_ = [
+      ("variant", ctypes.c_int32),
+      ("alternating_updates", ctypes.c_int32),
+      ("regret_pruning", ctypes.c_int32),
+      ("reserved", ctypes.c_int32),
+      ("alpha", ctypes.c_double),
+      ("beta", ctypes.c_double),
+      ("gamma", ctypes.c_double),
+      ("prune_threshold", ctypes.c_double),
+      ("discount_interval", ctypes.c_int64),
+      ("prune_warmup_iterations", ctypes.c_int64),
+      ("prune_recheck_interval", ctypes.c_int64),
+      ("table_capacity", ctypes.c_int64),
+      ("seed", ctypes.c_uint64),
+  ]
+
+
+class SchedulerOptions(ctypes.Structure):
+  """Mirror of PokerbotSchedulerOptions."""
+
+  _fields_ = [
+      ("num_hands", ctypes.c_int64),
+      ("concurrent_hands", ctypes.c_int32),
+      ("max_batch_size", ctypes.c_int32),
+      ("max_wait_ms", ctypes.c_double),
+      ("seed", ctypes.c_uint64),
+  ]
+
+
+BatchPolicyCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_void_p,
+    ctypes.c_int,
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.POINTER(ctypes.c_uint32),
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.c_void_p,
+)
+
+HandSinkCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_int64,
+    ctypes.POINTER(ctypes.c_uint8),
+    ctypes.POINTER(ctypes.c_int64),
+    ctypes.c_void_p,
+)
+
+HistoryRecordCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_uint64,
+    ctypes.POINTER(ctypes.c_uint8),
+    ctypes.POINTER(ctypes.c_int64),
+    ctypes.POINTER(ctypes.c_int),
+    ctypes.c_int,
+    ctypes.c_void_p,
+)
+
+RangeCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_int64,
+    ctypes.c_int64,
+    ctypes.c_void_p,
+)
+
+RangeSumCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_int64,
+    ctypes.c_int64,
+    ctypes.POINTER(ctypes.c_double),
+    ctypes.c_void_p,
+)
+
+
+class ReplayOptions(ctypes.Structure):
+  """Mirror of PokerbotReplayOptions."""
+
+  _fields_ = [
+      ("num_threads", ctypes.c_int32),
+      ("ordered", ctypes.c_int32),
+      ("failures_only", ctypes.c_int32),
+      ("max_buffered_blocks", ctypes.c_int32),
+  ]
+
+
+ReplayResultCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_int64,
+    ctypes.c_uint64,
+    ctypes.c_int,
+    ctypes.c_int,
+    ctypes.POINTER(ctypes.c_int64),
+    ctypes.c_void_p,
+)
+
+ReplayDecisionCallback = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.c_int64,
+    ctypes.POINTER(ctypes.c_uint8),
+    ctypes.c_int,
+    ctypes.c_void_p,
+)
+
+
 _LIB: Optional[ctypes.CDLL] = None
 
 
@@ -85,7 +253,7 @@ def _configure_signatures(lib: ctypes.CDLL) -> None:
   lib.pokerbot_state_reset.restype = None
   lib.pokerbot_state_reset.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
 
-  lib.pokerbot_state_reset_with_deck.restype = None
+  lib.pokerbot_state_reset_with_deck.restype = ctypes.c_int
   lib.pokerbot_state_reset_with_deck.argtypes = [
       ctypes.c_void_p,
       ctypes.POINTER(ctypes.c_uint8),
@@ -151,6 +319,413 @@ def _configure_signatures(lib: ctypes.CDLL) -> None:
       ctypes.POINTER(ctypes.c_int64),
   ]
 
+  lib.pokerbot_state_hand_strength.restype = ctypes.c_uint64
+  lib.pokerbot_state_hand_strength.argtypes = [ctypes.c_void_p, ctypes.c_int]
+
+  lib.pokerbot_evaluate_best_hand.restype = ctypes.c_uint64
+  lib.pokerbot_evaluate_best_hand.argtypes = [
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_evaluate_with_board.restype = ctypes.c_uint64
+  lib.pokerbot_evaluate_with_board.argtypes = [
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_snapshot_size.restype = ctypes.c_int
+  lib.pokerbot_snapshot_size.argtypes = []
+
+  lib.pokerbot_state_snapshot_batch.restype = ctypes.c_int
+  lib.pokerbot_state_snapshot_batch.argtypes = [
+      ctypes.POINTER(ctypes.c_void_p),
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_uint8),
+  ]
+
+  lib.pokerbot_state_restore_batch.restype = ctypes.c_int
+  lib.pokerbot_state_restore_batch.argtypes = [
+      ctypes.POINTER(ctypes.c_void_p),
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_uint8),
+  ]
+
+  lib.pokerbot_pool_create.restype = ctypes.c_void_p
+  lib.pokerbot_pool_create.argtypes = [ctypes.c_int]
+
+  lib.pokerbot_pool_destroy.restype = None
+  lib.pokerbot_pool_destroy.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_pool_capacity.restype = ctypes.c_int
+  lib.pokerbot_pool_capacity.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_pool_in_use.restype = ctypes.c_int
+  lib.pokerbot_pool_in_use.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_pool_acquire.restype = ctypes.c_int
+  lib.pokerbot_pool_acquire.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_uint64),
+  ]
+
+  lib.pokerbot_pool_release.restype = ctypes.c_int
+  lib.pokerbot_pool_release.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_pool_reset.restype = ctypes.c_int
+  lib.pokerbot_pool_reset.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_pool_reset_with_decks.restype = ctypes.c_int
+  lib.pokerbot_pool_reset_with_decks.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_pool_apply.restype = ctypes.c_int
+  lib.pokerbot_pool_apply.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.POINTER(ctypes.c_int),
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_int),
+  ]
+
+  lib.pokerbot_pool_query.restype = ctypes.c_int
+  lib.pokerbot_pool_query.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.c_int,
+      ctypes.POINTER(StateInfo),
+  ]
+
+  lib.pokerbot_cfr_default_options.restype = None
+  lib.pokerbot_cfr_default_options.argtypes = [ctypes.POINTER(CfrOptions)]
+
+  lib.pokerbot_cfr_create.restype = ctypes.c_void_p
+  lib.pokerbot_cfr_create.argtypes = [ctypes.POINTER(CfrOptions)]
+
+  lib.pokerbot_cfr_destroy.restype = None
+  lib.pokerbot_cfr_destroy.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_cfr_run.restype = ctypes.c_int
+  lib.pokerbot_cfr_run.argtypes = [ctypes.c_void_p, ctypes.c_int64]
+
+  lib.pokerbot_cfr_stats.restype = ctypes.c_int
+  lib.pokerbot_cfr_stats.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_int64),
+  ]
+
+  lib.pokerbot_cfr_average_strategy.restype = ctypes.c_int
+  lib.pokerbot_cfr_average_strategy.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_double),
+  ]
+
+  lib.pokerbot_cfr_infoset.restype = ctypes.c_int
+  lib.pokerbot_cfr_infoset.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_double),
+      ctypes.POINTER(ctypes.c_double),
+  ]
+
+  lib.pokerbot_cfr_apply_discounts.restype = ctypes.c_int
+  lib.pokerbot_cfr_apply_discounts.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int64,
+      ctypes.c_int64,
+  ]
+
+  lib.pokerbot_cfr_set_deals.restype = ctypes.c_int
+  lib.pokerbot_cfr_set_deals.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_cfr_exploitability.restype = ctypes.c_int
+  lib.pokerbot_cfr_exploitability.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_double),
+  ]
+
+  lib.pokerbot_shared_create.restype = ctypes.c_void_p
+  lib.pokerbot_shared_create.argtypes = [
+      ctypes.c_char_p,
+      ctypes.c_int64,
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_shared_attach.restype = ctypes.c_void_p
+  lib.pokerbot_shared_attach.argtypes = [ctypes.c_char_p]
+
+  lib.pokerbot_shared_close.restype = None
+  lib.pokerbot_shared_close.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_shared_iteration.restype = ctypes.c_int64
+  lib.pokerbot_shared_iteration.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_shared_request_stop.restype = ctypes.c_int
+  lib.pokerbot_shared_request_stop.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_shared_request_checkpoint.restype = ctypes.c_int64
+  lib.pokerbot_shared_request_checkpoint.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_char_p,
+  ]
+
+  lib.pokerbot_shared_wait_checkpoint.restype = ctypes.c_int
+  lib.pokerbot_shared_wait_checkpoint.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int64,
+      ctypes.c_double,
+  ]
+
+  lib.pokerbot_shared_load_checkpoint.restype = ctypes.c_int
+  lib.pokerbot_shared_load_checkpoint.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_char_p,
+  ]
+
+  lib.pokerbot_cfr_create_shared.restype = ctypes.c_void_p
+  lib.pokerbot_cfr_create_shared.argtypes = [
+      ctypes.POINTER(CfrOptions),
+      ctypes.c_void_p,
+  ]
+
+  lib.pokerbot_cfr_run_shared_round.restype = ctypes.c_int
+  lib.pokerbot_cfr_run_shared_round.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.c_int64,
+      ctypes.c_double,
+  ]
+
+  lib.pokerbot_combo_count.restype = ctypes.c_int
+  lib.pokerbot_combo_count.argtypes = []
+
+  lib.pokerbot_combo_index.restype = ctypes.c_int
+  lib.pokerbot_combo_index.argtypes = [ctypes.c_int, ctypes.c_int]
+
+  lib.pokerbot_combo_cards.restype = ctypes.c_int
+  lib.pokerbot_combo_cards.argtypes = [ctypes.c_int,
+                                       ctypes.POINTER(ctypes.c_uint8)]
+
+  lib.pokerbot_range_create.restype = ctypes.c_void_p
+  lib.pokerbot_range_create.argtypes = []
+
+  lib.pokerbot_range_destroy.restype = None
+  lib.pokerbot_range_destroy.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_range_reset.restype = None
+  lib.pokerbot_range_reset.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_range_remove_cards.restype = ctypes.c_int
+  lib.pokerbot_range_remove_cards.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_range_update.restype = ctypes.c_int
+  lib.pokerbot_range_update.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_float),
+  ]
+
+  lib.pokerbot_range_observe_cfr.restype = ctypes.c_int
+  lib.pokerbot_range_observe_cfr.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_range_total.restype = ctypes.c_double
+  lib.pokerbot_range_total.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_range_weights.restype = ctypes.c_int
+  lib.pokerbot_range_weights.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_float),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_cfr_action_likelihoods.restype = ctypes.c_int
+  lib.pokerbot_cfr_action_likelihoods.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_float),
+  ]
+
+  lib.pokerbot_ismcts_search.restype = ctypes.c_int
+  lib.pokerbot_ismcts_search.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int,
+      ctypes.c_int64,
+      ctypes.c_double,
+      ctypes.c_uint64,
+      ctypes.POINTER(ctypes.c_int64),
+      ctypes.POINTER(ctypes.c_double),
+  ]
+
+  lib.pokerbot_thread_pool_configure.restype = ctypes.c_int
+  lib.pokerbot_thread_pool_configure.argtypes = [
+      ctypes.c_int,
+      ctypes.c_int,
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_thread_pool_size.restype = ctypes.c_int
+  lib.pokerbot_thread_pool_size.argtypes = []
+
+  lib.pokerbot_task_seed.restype = ctypes.c_uint64
+  lib.pokerbot_task_seed.argtypes = [ctypes.c_uint64, ctypes.c_uint64]
+
+  lib.pokerbot_parallel_for.restype = ctypes.c_int
+  lib.pokerbot_parallel_for.argtypes = [
+      ctypes.c_int64,
+      ctypes.c_int64,
+      ctypes.c_int64,
+      RangeCallback,
+      ctypes.c_void_p,
+  ]
+
+  lib.pokerbot_parallel_sum.restype = ctypes.c_int
+  lib.pokerbot_parallel_sum.argtypes = [
+      ctypes.c_int64,
+      ctypes.c_int64,
+      ctypes.c_int64,
+      RangeSumCallback,
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_double),
+  ]
+
+  lib.pokerbot_observation_size.restype = ctypes.c_int
+  lib.pokerbot_observation_size.argtypes = []
+
+  lib.pokerbot_scheduler_default_options.restype = None
+  lib.pokerbot_scheduler_default_options.argtypes = [
+      ctypes.POINTER(SchedulerOptions),
+  ]
+
+  lib.pokerbot_scheduler_run.restype = ctypes.c_int
+  lib.pokerbot_scheduler_run.argtypes = [
+      ctypes.POINTER(SchedulerOptions),
+      BatchPolicyCallback,
+      HandSinkCallback,
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_int64),
+  ]
+
+  lib.pokerbot_scheduler_batch_snapshot.restype = ctypes.c_int
+  lib.pokerbot_scheduler_batch_snapshot.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_uint8),
+  ]
+
+  lib.pokerbot_history_writer_open.restype = ctypes.c_void_p
+  lib.pokerbot_history_writer_open.argtypes = [
+      ctypes.c_char_p,
+      ctypes.c_int,
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_history_writer_append_state.restype = ctypes.c_int
+  lib.pokerbot_history_writer_append_state.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_void_p,
+      ctypes.c_uint64,
+  ]
+
+  lib.pokerbot_history_writer_flush.restype = ctypes.c_int
+  lib.pokerbot_history_writer_flush.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_history_writer_close.restype = ctypes.c_int
+  lib.pokerbot_history_writer_close.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_history_reader_open.restype = ctypes.c_void_p
+  lib.pokerbot_history_reader_open.argtypes = [ctypes.c_char_p]
+
+  lib.pokerbot_history_reader_close.restype = None
+  lib.pokerbot_history_reader_close.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_history_reader_size.restype = ctypes.c_int64
+  lib.pokerbot_history_reader_size.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_history_reader_read.restype = ctypes.c_int
+  lib.pokerbot_history_reader_read.argtypes = [
+      ctypes.c_void_p,
+      ctypes.c_int64,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.POINTER(ctypes.c_int64),
+      ctypes.POINTER(ctypes.c_int),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_history_cursor_open.restype = ctypes.c_void_p
+  lib.pokerbot_history_cursor_open.argtypes = [ctypes.c_void_p, ctypes.c_int64]
+
+  lib.pokerbot_history_cursor_close.restype = None
+  lib.pokerbot_history_cursor_close.argtypes = [ctypes.c_void_p]
+
+  lib.pokerbot_history_cursor_next.restype = ctypes.c_int
+  lib.pokerbot_history_cursor_next.argtypes = [
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_uint64),
+      ctypes.POINTER(ctypes.c_uint8),
+      ctypes.POINTER(ctypes.c_int64),
+      ctypes.POINTER(ctypes.c_int),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_history_reader_for_each.restype = ctypes.c_int64
+  lib.pokerbot_history_reader_for_each.argtypes = [
+      ctypes.c_void_p,
+      HistoryRecordCallback,
+      HistoryRecordCallback,
+      ctypes.c_void_p,
+  ]
+
+  lib.pokerbot_replay_history.restype = ctypes.c_int
+  lib.pokerbot_replay_history.argtypes = [
+      ctypes.c_char_p,
+      ctypes.c_int,
+      ctypes.POINTER(ctypes.c_int64),
+      ctypes.POINTER(ctypes.c_int64),
+      ctypes.c_int,
+  ]
+
+  lib.pokerbot_replay_run.restype = ctypes.c_int
+  lib.pokerbot_replay_run.argtypes = [
+      ctypes.c_char_p,
+      ctypes.POINTER(ReplayOptions),
+      ReplayResultCallback,
+      ReplayDecisionCallback,
+      ctypes.c_void_p,
+      ctypes.POINTER(ctypes.c_int64),
+  ]
+
 
 class NativeGameStateHolder:
   """Thin RAII wrapper around the native game state pointer."""
@@ -190,7 +765,8 @@ class NativeGameStateHolder:
       raise ValueError("Deck must contain at least 52 cards")
     arr_type = ctypes.c_uint8 * len(deck)
     arr = arr_type(*deck)
-    self._lib.pokerbot_state_reset_with_deck(self.ptr, arr, len(deck))
+    if not self._lib.pokerbot_state_reset_with_deck(self.ptr, arr, len(deck)):
+      raise ValueError("Deck must be a permutation of the 52 cards")
 
   def legal_actions(self, max_actions: int = 4) -> List[int]:
     buffer_type = ctypes.c_int * max_actions
@@ -222,3 +798,37 @@ class NativeGameStateHolder:
     self._lib.pokerbot_state_payoffs(self.ptr, buffer)
     return [int(buffer[0]), int(buffer[1])]
 
+  def snapshot(self) -> bytes:
+    return snapshot_states([self])
+
+  def restore(self, snapshot: bytes) -> None:
+    restore_states([self], snapshot)
+
+
+def snapshot_states(holders: Sequence[NativeGameStateHolder]) -> bytes:
+  """Packs the given states into consecutive fixed-size snapshots."""
+  lib = load_library()
+  size = lib.pokerbot_snapshot_size()
+  count = len(holders)
+  pointers = (ctypes.c_void_p * count)(*(h.ptr.value for h in holders))
+  buffer = (ctypes.c_uint8 * (size * count))()
+  written = lib.pokerbot_state_snapshot_batch(pointers, count, buffer)
+  if written != count:
+    raise RuntimeError(f"Failed to snapshot state {written}")
+  return bytes(buffer)
+
+
+def restore_states(holders: Sequence[NativeGameStateHolder],
+                   snapshots: bytes) -> None:
+  """Restores states from the output of snapshot_states()."""
+  lib = load_library()
+  size = lib.pokerbot_snapshot_size()
+  count = len(holders)
+  if len(snapshots) != size * count:
+    raise ValueError("Snapshot buffer does not match the number of states")
+  pointers = (ctypes.c_void_p * count)(*(h.ptr.value for h in holders))
+  buffer = (ctypes.c_uint8 * len(snapshots)).from_buffer_copy(snapshots)
+  restored = lib.pokerbot_state_restore_batch(pointers, count, buffer)
+  if restored != count:
+    raise ValueError(f"Invalid snapshot for state {restored}")
+
@@ -0,0 +1,94 @@
+"""Control of the native worker pool shared by parallel core workloads."""
+
+from __future__ import annotations
+
+import ctypes
+from enum import IntEnum
+from typing import Callable, List
+
+from .native import RangeCallback, RangeSumCallback, load_library
+
+__all__ = ["NumaPolicy", "configure_thread_pool", "thread_pool_size",
+           "task_seed", "parallel_for", "parallel_sum"]
+
+
+class NumaPolicy(IntEnum):
+  NONE = 0
+  COMPACT = 1
+  SPREAD = 2
+
+
+def configure_thread_pool(num_threads: int = 0,
+                          pin_threads: bool = False,
+                          numa_policy: NumaPolicy = NumaPolicy.NONE) -> None:
+  """Replaces the shared pool; `num_threads` counts the calling thread."""
+  status = load_library().pokerbot_thread_pool_configure(
+      int(num_threads), 1 if pin_threads else 0, int(numa_policy))
+  if status != 0:
+    raise ValueError(
+        f"Invalid thread pool configuration (status {status})")
+
+
+def thread_pool_size() -> int:
+  return int(load_library().pokerbot_thread_pool_size())
+
+
+def task_seed(base_seed: int, index: int) -> int:
+  """Seed the native pool derives for task `index` of a job."""
+  return int(load_library().pokerbot_task_seed(base_seed, index))
+
+
+def parallel_for(begin: int, end: int, grain: int,
+                 body: Callable[[int, int], None]) -> None:
+  """Runs body(lo, hi) for each chunk of [begin, end) on the native pool.
+
+  Chunks run on pool workers and the calling thread. The first exception
+  stops the loop and is re-raised here.
+  """
+  errors: List[BaseException] = []
+
+  def _chunk(lo, hi, _):
+    if errors:
+      return 1
+    try:
+      body(int(lo), int(hi))
+      return 0
+    except BaseException as exc:  # Re-raised once the loop unwinds.
+      errors.append(exc)
+      return 1
+
+  status = load_library().pokerbot_parallel_for(
+      int(begin), int(end), int(grain), RangeCallback(_chunk), None)
+  if errors:
+    raise errors[0]
+  if status != 0:
+    raise ValueError(f"Invalid parallel range (status {status})")
+
+
+def parallel_sum(begin: int, end: int, grain: int,
+                 chunk_value: Callable[[int, int], float]) -> float:
+  """Sums chunk_value(lo, hi) over the chunks of [begin, end) in index order.
+
+  The result is independent of the pool size.
+  """
+  errors: List[BaseException] = []
+
+  def _chunk(lo, hi, value, _):
+    if errors:
+      return 1
+    try:
+      value[0] = float(chunk_value(int(lo), int(hi)))
+      return 0
+    except BaseException as exc:
+      errors.append(exc)
+      return 1
+
+  out = ctypes.c_double()
+  status = load_library().pokerbot_parallel_sum(
+      int(begin), int(end), int(grain), RangeSumCallback(_chunk), None,
+      ctypes.byref(out))
+  if errors:
+    raise errors[0]
+  if status != 0:
+    raise ValueError(f"Invalid parallel range (status {status})")
+  return out.value
@@ -0,0 +1,108 @@
+"""Batched access to a native pool of preallocated game states."""
+
+from __future__ import annotations
+
+import ctypes
+from typing import List, Sequence
+
+from .native import StateInfo, Status, load_library
+
+__all__ = ["PoolStatus", "PoolError", "StatePool", "StateInfo"]
+
+# Kept for callers written before the status codes moved to native.Status.
+PoolStatus = Status
+
+
+class PoolError(RuntimeError):
+  def __init__(self, status: int, message: str) -> None:
+    super().__init__(f"{message}: {Status(status).name}")
+    self.status = Status(status)
+
+
+def _handles(handles: Sequence[int]) -> ctypes.Array:
+  return (ctypes.c_uint64 * len(handles))(*handles)
+
+
+class StatePool:
+  """Fixed-capacity arena of native states addressed by integer handles."""
+
+  def __init__(self, capacity: int) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_pool_create(int(capacity))
+    if not ptr:
+      raise RuntimeError(f"Failed to allocate state pool of {capacity}")
+    self._ptr = ctypes.c_void_p(ptr)
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      self._lib.pokerbot_pool_destroy(self._ptr)
+      self._ptr = None
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+  @property
+  def capacity(self) -> int:
+    return self._lib.pokerbot_pool_capacity(self._ptr)
+
+  @property
+  def in_use(self) -> int:
+    return self._lib.pokerbot_pool_in_use(self._ptr)
+
+  def _check(self, status: int, message: str) -> None:
+    if status != Status.OK:
+      raise PoolError(status, message)
+
+  def acquire(self, count: int) -> List[int]:
+    out = (ctypes.c_uint64 * count)()
+    self._check(self._lib.pokerbot_pool_acquire(self._ptr, count, out),
+                "Failed to acquire states")
+    return list(out)
+
+  def release(self, handles: Sequence[int]) -> None:
+    self._check(
+        self._lib.pokerbot_pool_release(self._ptr, _handles(handles),
+                                        len(handles)),
+        "Failed to release states")
+
+  def reset(self, handles: Sequence[int], seeds: Sequence[int]) -> None:
+    if len(seeds) != len(handles):
+      raise ValueError("Expected one seed per handle")
+    seed_array = (ctypes.c_uint64 * len(seeds))(*seeds)
+    self._check(
+        self._lib.pokerbot_pool_reset(self._ptr, _handles(handles), seed_array,
+                                      len(handles)),
+        "Failed to reset states")
+
+  def reset_with_decks(self, handles: Sequence[int],
+                       decks: Sequence[Sequence[int]]) -> None:
+    if len(decks) != len(handles) or any(len(deck) != 52 for deck in decks):
+      raise ValueError("Expected one 52-card deck per handle")
+    flat = (ctypes.c_uint8 * (52 * len(decks)))(
+        *(card for deck in decks for card in deck))
+    self._check(
+        self._lib.pokerbot_pool_reset_with_decks(self._ptr, _handles(handles),
+                                                 flat, len(handles)),
+        "Failed to reset states")
+
+  def apply(self, handles: Sequence[int],
+            actions: Sequence[int]) -> List[Status]:
+    """Applies one action per state; returns per-state statuses."""
+    if len(actions) != len(handles):
+      raise ValueError("Expected one action per handle")
+    action_array = (ctypes.c_int * len(actions))(*(int(a) for a in actions))
+    statuses = (ctypes.c_int * len(handles))()
+    self._lib.pokerbot_pool_apply(self._ptr, _handles(handles), action_array,
+                                  len(handles), statuses)
+    return [Status(status) for status in statuses]
+
+  def query(self, handles: Sequence[int]) -> List[StateInfo]:
+    out = (StateInfo * len(handles))()
+    self._check(
+        self._lib.pokerbot_pool_query(self._ptr, _handles(handles),
+                                      len(handles), out),
+        "Failed to query states")
+    return list(out)
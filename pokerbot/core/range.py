@@ -0,0 +1,94 @@
+"""Native posterior over the opponent's two-card holdings."""
+
+from __future__ import annotations
+
+import ctypes
+from typing import Iterable, List, Optional, Sequence, Tuple
+
+from .limit_holdem import LimitHoldemState
+from .native import Status, load_library
+
+__all__ = ["NUM_COMBOS", "OpponentRange", "combo_cards", "combo_index"]
+
+NUM_COMBOS = 1326
+
+
+def combo_index(card_a: int, card_b: int) -> int:
+  index = load_library().pokerbot_combo_index(int(card_a), int(card_b))
+  if index < 0:
+    raise ValueError(f"Invalid holding ({card_a}, {card_b})")
+  return int(index)
+
+
+def combo_cards(index: int) -> Tuple[int, int]:
+  out = (ctypes.c_uint8 * 2)()
+  if load_library().pokerbot_combo_cards(int(index), out) != 0:
+    raise ValueError(f"Invalid holding index {index}")
+  return int(out[0]), int(out[1])
+
+
+class OpponentRange:
+  """Weights over the 1326 holdings, indexed by :func:`combo_index`.
+
+  Call :meth:`observe` at each decision to fold in new board cards and
+  opponent actions, or drive it manually with :meth:`remove_cards` and
+  :meth:`update`.
+  """
+
+  def __init__(self) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_range_create()
+    if not ptr:
+      raise RuntimeError("Failed to allocate opponent range")
+    self._ptr: Optional[ctypes.c_void_p] = ctypes.c_void_p(ptr)
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      self._lib.pokerbot_range_destroy(self._ptr)
+      self._ptr = None
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+  def reset(self) -> None:
+    self._lib.pokerbot_range_reset(self._ptr)
+
+  def remove_cards(self, cards: Iterable[int]) -> None:
+    cards = list(cards)
+    buffer = (ctypes.c_uint8 * max(len(cards), 1))(*cards)
+    if self._lib.pokerbot_range_remove_cards(self._ptr, buffer,
+                                             len(cards)) != 0:
+      raise ValueError(f"Invalid cards {cards}")
+
+  def update(self, likelihood: Sequence[float]) -> bool:
+    """Multiplies in per-holding probabilities of an observed action.
+
+    Returns False (leaving the range unchanged) when no live holding is
+    consistent with the evidence.
+    """
+    if len(likelihood) != NUM_COMBOS:
+      raise ValueError(f"Expected {NUM_COMBOS} likelihoods")
+    buffer = (ctypes.c_float * NUM_COMBOS)(*likelihood)
+    return self._lib.pokerbot_range_update(self._ptr, buffer) == Status.OK
+
+  def observe(self, trainer, state: LimitHoldemState, observer: int) -> bool:
+    """Catches up with `state` using a CFR trainer's average strategy."""
+    status = self._lib.pokerbot_range_observe_cfr(
+        self._ptr, trainer._ptr, state._holder.ptr, int(observer))
+    if status == Status.INVALID_ARGUMENT:
+      raise ValueError("State does not continue the observed hand")
+    if status not in (Status.OK, Status.EMPTY_RANGE):
+      raise RuntimeError(f"Range update failed: {Status(status).name}")
+    return status == Status.OK
+
+  @property
+  def total(self) -> float:
+    return float(self._lib.pokerbot_range_total(self._ptr))
+
+  def weights(self, normalized: bool = True) -> List[float]:
+    out = (ctypes.c_float * NUM_COMBOS)()
+    self._lib.pokerbot_range_weights(self._ptr, out, 1 if normalized else 0)
+    return list(out)
@@ -0,0 +1,149 @@
+"""Batched self-play: many native hands share one policy call per batch."""
+
+from __future__ import annotations
+
+import ctypes
+from dataclasses import dataclass
+from typing import Callable, List, Optional, Sequence, Tuple
+
+from .limit_holdem import LimitHoldemState
+from .native import (BatchPolicyCallback, HandSinkCallback, SchedulerOptions,
+                     Status, load_library)
+from .pool import PoolError
+
+__all__ = ["InferenceBatch", "SchedulerStats", "observation_size",
+           "run_batched_self_play"]
+
+_NUM_ACTIONS = 5
+
+
+def observation_size() -> int:
+  """Floats per encoded observation (see inference_scheduler.h)."""
+  return int(load_library().pokerbot_observation_size())
+
+
+class InferenceBatch:
+  """Decisions parked by the scheduler, valid only during the policy call.
+
+  Row i of :attr:`observations` (``observation_size()`` floats, a ctypes
+  view over native memory) and :attr:`legal_masks` describe the same
+  decision; :meth:`state` rebuilds it as a :class:`LimitHoldemState`.
+  """
+
+  def __init__(self, handle, size: int, observations, legal_masks,
+               width: int) -> None:
+    self.size = size
+    self.observations = observations
+    self.legal_masks = legal_masks
+    self._handle = handle
+    self._width = width
+
+  def observation(self, index: int) -> List[float]:
+    start = index * self._width
+    return list(self.observations[start:start + self._width])
+
+  def state(self, index: int) -> LimitHoldemState:
+    """Snapshots row `index` natively on demand."""
+    if self._handle is None:
+      raise RuntimeError("Batch states are only valid during the policy call")
+    if not 0 <= index < self.size:
+      raise IndexError(f"Batch row {index} out of range")
+    lib = load_library()
+    snapshot = (ctypes.c_uint8 * lib.pokerbot_snapshot_size())()
+    status = lib.pokerbot_scheduler_batch_snapshot(self._handle, int(index),
+                                                   snapshot)
+    if status != Status.OK:
+      raise PoolError(status, "Batch is no longer valid")
+    state = LimitHoldemState(seed=0)
+    state.restore(bytes(snapshot))
+    return state
+
+
+@dataclass
+class SchedulerStats:
+  hands: int
+  decisions: int
+  batches: int
+  largest_batch: int
+  payoff_sums: Tuple[int, int]
+
+
+BatchPolicy = Callable[[InferenceBatch], Sequence[Sequence[float]]]
+HandCallback = Callable[[int, Tuple[int, int], bytes], None]
+
+
+def run_batched_self_play(policy: BatchPolicy,
+                          num_hands: int,
+                          *,
+                          concurrent_hands: int = 1024,
+                          max_batch_size: int = 256,
+                          max_wait_ms: float = 1.0,
+                          seed: int = 0,
+                          on_hand: Optional[HandCallback] = None
+                          ) -> SchedulerStats:
+  """Plays `num_hands` self-play hands, keeping `concurrent_hands` in flight.
+
+  `policy` receives an :class:`InferenceBatch` and returns one row of five
+  action probabilities (indexed by action code) per decision; illegal
+  actions are ignored. `on_hand(index, payoffs, snapshot)` runs as each hand
+  finishes, not necessarily in index order. Both run on the calling thread,
+  and an exception from either stops the run and is re-raised here.
+  """
+  lib = load_library()
+  options = SchedulerOptions()
+  lib.pokerbot_scheduler_default_options(ctypes.byref(options))
+  options.num_hands = int(num_hands)
+  options.concurrent_hands = int(concurrent_hands)
+  options.max_batch_size = int(max_batch_size)
+  options.max_wait_ms = float(max_wait_ms)
+  options.seed = int(seed)
+
+  width = observation_size()
+  snapshot_size = lib.pokerbot_snapshot_size()
+  errors: List[BaseException] = []
+
+  def _policy(handle, size, observations, legal_masks, probabilities, _):
+    try:
+      view = ctypes.cast(observations,
+                         ctypes.POINTER(ctypes.c_float * (size * width)))
+      batch = InferenceBatch(handle, size, view.contents, legal_masks[:size],
+                             width)
+      try:
+        rows = policy(batch)
+      finally:
+        batch._handle = None
+      if len(rows) != size:
+        raise ValueError(f"Policy returned {len(rows)} rows for {size}")
+      for i, row in enumerate(rows):
+        if len(row) != _NUM_ACTIONS:
+          raise ValueError(f"Expected {_NUM_ACTIONS} probabilities per row")
+        for action, probability in enumerate(row):
+          probabilities[i * _NUM_ACTIONS + action] = float(probability)
+      return 0
+    except BaseException as exc:  # Re-raised once the native run unwinds.
+      errors.append(exc)
+      return 1
+
+  def _sink(hand_index, snapshot, payoffs, _):
+    try:
+      on_hand(int(hand_index), (int(payoffs[0]), int(payoffs[1])),
+              ctypes.string_at(snapshot, snapshot_size))
+      return 0
+    except BaseException as exc:
+      errors.append(exc)
+      return 1
+
+  policy_callback = BatchPolicyCallback(_policy)
+  sink_callback = HandSinkCallback(_sink) if on_hand else HandSinkCallback()
+  stats = (ctypes.c_int64 * 6)()
+  status = lib.pokerbot_scheduler_run(ctypes.byref(options), policy_callback,
+                                      sink_callback, None, stats)
+  if errors:
+    raise errors[0]
+  if status == Status.INVALID_ARGUMENT:
+    raise ValueError("Invalid scheduler options")
+  if status != Status.OK:
+    raise PoolError(status, "Batched self-play failed")
+  return SchedulerStats(hands=stats[0], decisions=stats[1], batches=stats[2],
+                        largest_batch=stats[3],
+                        payoff_sums=(stats[4], stats[5]))
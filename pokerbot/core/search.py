@@ -0,0 +1,46 @@
+"""Search-based decision making on top of the native engine."""
+
+from __future__ import annotations
+
+import ctypes
+import random
+from dataclasses import dataclass, field
+from typing import Dict, Optional
+
+from .limit_holdem import ActionType, LimitHoldemState
+from .native import load_library
+
+__all__ = ["SearchResult", "ismcts_search"]
+
+_NUM_ACTION_CODES = 5
+
+
+@dataclass
+class SearchResult:
+  action: ActionType
+  visits: Dict[ActionType, int] = field(default_factory=dict)
+  values: Dict[ActionType, float] = field(default_factory=dict)
+
+
+def ismcts_search(state: LimitHoldemState,
+                  max_iterations: int = 10000,
+                  time_budget_ms: float = 0.0,
+                  num_threads: int = 0,
+                  seed: Optional[int] = None) -> SearchResult:
+  """Runs multithreaded ISMCTS for the player to act in `state`."""
+  if seed is None:
+    seed = random.getrandbits(64)
+  lib = load_library()
+  visits = (ctypes.c_int64 * _NUM_ACTION_CODES)()
+  values = (ctypes.c_double * _NUM_ACTION_CODES)()
+  action = lib.pokerbot_ismcts_search(
+      state._holder.ptr, int(num_threads), int(max_iterations),
+      float(time_budget_ms), ctypes.c_uint64(seed), visits, values)
+  if action < 0:
+    raise RuntimeError("ISMCTS search failed")
+  legal = state.legal_actions()
+  return SearchResult(
+      action=ActionType(action),
+      visits={a: int(visits[int(a)]) for a in legal},
+      values={a: float(values[int(a)]) for a in legal},
+  )
@@ -0,0 +1,7 @@
+"""Training loops driving the native solvers."""
+
+from .cfr import CfrStats, CfrTrainer, CfrVariant
+from .shared import SharedCfrTrainer, SharedRegretTable, run_shared_worker
+
+__all__ = ["CfrStats", "CfrTrainer", "CfrVariant", "SharedCfrTrainer",
+           "SharedRegretTable", "run_shared_worker"]
@@ -0,0 +1,136 @@
+"""Python driver for the native CFR trainer."""
+
+from __future__ import annotations
+
+import ctypes
+from dataclasses import dataclass
+from enum import IntEnum
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+from pokerbot.core.native import CfrOptions, load_library
+from pokerbot.core.range import NUM_COMBOS
+
+__all__ = ["CfrStats", "CfrTrainer", "CfrVariant"]
+
+
+class CfrVariant(IntEnum):
+  VANILLA = 0
+  CFR_PLUS = 1
+  LINEAR = 2
+  DISCOUNTED = 3
+
+
+@dataclass
+class CfrStats:
+  iterations: int
+  infosets: int
+  nodes_visited: int
+  actions_pruned: int
+
+
+def _deck_buffer(decks: Sequence[Sequence[int]]) -> ctypes.Array:
+  buffer = (ctypes.c_uint8 * (52 * max(len(decks), 1)))()
+  for i, deck in enumerate(decks):
+    if len(deck) != 52:
+      raise ValueError("Each deal must list all 52 cards")
+    buffer[52 * i:52 * (i + 1)] = list(deck)
+  return buffer
+
+
+class CfrTrainer:
+  """Chance-sampled CFR with selectable update rules and regret pruning.
+
+  Keyword arguments override fields of the native defaults, e.g.
+  ``CfrTrainer(variant=CfrVariant.CFR_PLUS, regret_pruning=True)``.
+  """
+
+  def __init__(self, **overrides) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_cfr_create(ctypes.byref(self._options(overrides)))
+    if not ptr:
+      raise ValueError("Invalid CFR options")
+    self._ptr: Optional[ctypes.c_void_p] = ctypes.c_void_p(ptr)
+
+  def _options(self, overrides: Dict[str, object]) -> CfrOptions:
+    options = CfrOptions()
+    self._lib.pokerbot_cfr_default_options(ctypes.byref(options))
+    for name, value in overrides.items():
+      if not hasattr(options, name):
+        raise TypeError(f"Unknown CFR option '{name}'")
+      setattr(options, name, int(value) if isinstance(value, bool) else value)
+    return options
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      self._lib.pokerbot_cfr_destroy(self._ptr)
+      self._ptr = None
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+  def run(self, iterations: int) -> None:
+    status = self._lib.pokerbot_cfr_run(self._ptr, int(iterations))
+    if status != 0:
+      raise RuntimeError(f"CFR training failed with status {status}")
+
+  def set_deals(self, decks: Sequence[Sequence[int]]) -> None:
+    """Samples chance from these 52-card decks only; empty restores shuffling."""
+    buffer = _deck_buffer(decks)
+    if self._lib.pokerbot_cfr_set_deals(self._ptr, buffer, len(decks)) != 0:
+      raise ValueError("Every deal must be a permutation of the 52 cards")
+
+  def exploitability(self, decks: Sequence[Sequence[int]]) -> float:
+    """NashConv of the average strategy over exactly these deals, in chips."""
+    out = ctypes.c_double()
+    status = self._lib.pokerbot_cfr_exploitability(
+        self._ptr, _deck_buffer(decks), len(decks), ctypes.byref(out))
+    if status != 0:
+      raise ValueError("Exploitability needs one or more valid 52-card decks")
+    return out.value
+
+  def apply_discounts(self, from_iteration: int, to_iteration: int) -> None:
+    """Applies the discounts due in (from_iteration, to_iteration]."""
+    status = self._lib.pokerbot_cfr_apply_discounts(
+        self._ptr, int(from_iteration), int(to_iteration))
+    if status != 0:
+      raise ValueError("Invalid discount iteration range")
+
+  def infoset(self, state: LimitHoldemState
+              ) -> Tuple[Dict[ActionType, float], Dict[ActionType, float]]:
+    """Raw (regrets, strategy sums) of the player to act's information set."""
+    regrets = (ctypes.c_double * 5)()
+    sums = (ctypes.c_double * 5)()
+    status = self._lib.pokerbot_cfr_infoset(self._ptr, state._holder.ptr,
+                                            regrets, sums)
+    if status != 0:
+      raise ValueError("No decision to query in this state")
+    actions = state.legal_actions()
+    return ({action: float(regrets[int(action)]) for action in actions},
+            {action: float(sums[int(action)]) for action in actions})
+
+  def stats(self) -> CfrStats:
+    out = (ctypes.c_int64 * 4)()
+    self._lib.pokerbot_cfr_stats(self._ptr, out)
+    return CfrStats(*(int(value) for value in out))
+
+  def average_strategy(self, state: LimitHoldemState) -> Dict[ActionType, float]:
+    out = (ctypes.c_double * 5)()
+    status = self._lib.pokerbot_cfr_average_strategy(
+        self._ptr, state._holder.ptr, out)
+    if status != 0:
+      raise ValueError("No decision to query in this state")
+    return {action: float(out[int(action)]) for action in state.legal_actions()}
+
+  def action_likelihoods(self, state: LimitHoldemState,
+                         action: ActionType) -> List[float]:
+    """Per-holding probability of `action` under the average strategy."""
+    out = (ctypes.c_float * NUM_COMBOS)()
+    status = self._lib.pokerbot_cfr_action_likelihoods(
+        self._ptr, state._holder.ptr, int(action), out)
+    if status != 0:
+      raise ValueError(f"{action.name} is not legal in this state")
+    return list(out)
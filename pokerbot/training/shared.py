@@ -0,0 +1,149 @@
+"""Multi-process CFR over a regret table in named POSIX shared memory.
+
+A coordinator creates a :class:`SharedRegretTable` for ``num_workers``
+processes. Each worker attaches by name and trains in rounds with a
+:class:`SharedCfrTrainer`; every round ends at a cross-process barrier where
+discounts, checkpoints and stop requests take effect. For example::
+
+  table = SharedRegretTable.create("pokerbot-cfr", num_workers=8)
+  procs = [multiprocessing.Process(target=run_shared_worker,
+                                   args=("pokerbot-cfr", i, 100))
+           for i in range(8)]
+  ...
+  table.checkpoint("cfr.ckpt")
+  table.request_stop()
+"""
+
+from __future__ import annotations
+
+import ctypes
+from typing import Optional
+
+from pokerbot.core.native import Status, load_library
+from pokerbot.core.parallel import task_seed
+
+from .cfr import CfrTrainer
+
+__all__ = ["SharedCfrTrainer", "SharedRegretTable", "run_shared_worker"]
+
+
+class SharedRegretTable:
+  """Handle to a shared training segment; the creator unlinks it on close."""
+
+  def __init__(self, ptr: int, name: str) -> None:
+    self._lib = load_library()
+    self._ptr: Optional[ctypes.c_void_p] = ctypes.c_void_p(ptr)
+    self.name = name
+
+  @classmethod
+  def create(cls, name: str, num_workers: int,
+             table_capacity: int = 1 << 20) -> "SharedRegretTable":
+    ptr = load_library().pokerbot_shared_create(
+        name.encode(), int(table_capacity), int(num_workers))
+    if not ptr:
+      raise RuntimeError(f"Failed to create shared segment '{name}'")
+    return cls(ptr, name)
+
+  @classmethod
+  def attach(cls, name: str) -> "SharedRegretTable":
+    ptr = load_library().pokerbot_shared_attach(name.encode())
+    if not ptr:
+      raise RuntimeError(f"Failed to attach shared segment '{name}'")
+    return cls(ptr, name)
+
+  def close(self) -> None:
+    if getattr(self, "_ptr", None):
+      self._lib.pokerbot_shared_close(self._ptr)
+      self._ptr = None
+
+  def __del__(self) -> None:
+    try:
+      self.close()
+    except Exception:
+      pass
+
+  @property
+  def iteration(self) -> int:
+    """Iterations completed by all workers as of the last round."""
+    return int(self._lib.pokerbot_shared_iteration(self._ptr))
+
+  def request_stop(self) -> None:
+    """Workers return from their next round boundary and stop."""
+    self._lib.pokerbot_shared_request_stop(self._ptr)
+
+  def request_checkpoint(self, path: str) -> int:
+    """Schedules a checkpoint at the next round boundary; returns a ticket."""
+    ticket = self._lib.pokerbot_shared_request_checkpoint(
+        self._ptr, path.encode())
+    if ticket < 0:
+      raise ValueError(f"Invalid checkpoint path '{path}'")
+    if ticket == 0:
+      raise RuntimeError("A checkpoint request is already pending")
+    return int(ticket)
+
+  def wait_checkpoint(self, ticket: int, timeout_ms: float = 0.0) -> bool:
+    status = self._lib.pokerbot_shared_wait_checkpoint(
+        self._ptr, int(ticket), float(timeout_ms))
+    if status == Status.TIMEOUT:
+      return False
+    if status != Status.OK:
+      raise OSError(f"Checkpoint failed: {Status(status).name}")
+    return True
+
+  def checkpoint(self, path: str, timeout_ms: float = 0.0) -> bool:
+    return self.wait_checkpoint(self.request_checkpoint(path), timeout_ms)
+
+  def load_checkpoint(self, path: str) -> None:
+    """Restores the table and iteration count; call before workers start."""
+    status = self._lib.pokerbot_shared_load_checkpoint(
+        self._ptr, path.encode())
+    if status != Status.OK:
+      raise OSError(f"Failed to load checkpoint '{path}'")
+
+
+class SharedCfrTrainer(CfrTrainer):
+  """CFR trainer whose regrets live in a :class:`SharedRegretTable`."""
+
+  def __init__(self, table: SharedRegretTable, **overrides) -> None:
+    self._lib = load_library()
+    ptr = self._lib.pokerbot_cfr_create_shared(
+        ctypes.byref(self._options(overrides)), table._ptr)
+    if not ptr:
+      raise ValueError("Invalid CFR options")
+    self._ptr = ctypes.c_void_p(ptr)
+    # The native trainer points into the segment's mapping.
+    self._table = table
+
+  def close(self) -> None:
+    super().close()
+    self._table = None
+
+  def run_round(self, iterations: int, timeout_ms: float = 0.0) -> bool:
+    """Runs one round; returns False once the coordinator requested a stop."""
+    status = self._lib.pokerbot_cfr_run_shared_round(
+        self._ptr, self._table._ptr, int(iterations), float(timeout_ms))
+    if status == Status.STOPPED:
+      return False
+    if status == Status.TIMEOUT:
+      raise TimeoutError("Shared training barrier timed out")
+    if status != Status.OK:
+      raise RuntimeError(
+          f"Shared CFR round failed: {Status(status).name}")
+    return True
+
+
+def run_shared_worker(name: str, worker_index: int,
+                      iterations_per_round: int, base_seed: int = 0,
+                      timeout_ms: float = 0.0, **overrides) -> int:
+  """Worker process entry point: trains until stopped, returns rounds run."""
+  table = SharedRegretTable.attach(name)
+  trainer = SharedCfrTrainer(table, seed=task_seed(base_seed, worker_index),
+                             **overrides)
+  rounds = 0
+  try:
+    while trainer.run_round(iterations_per_round, timeout_ms):
+      rounds += 1
+  finally:
+    trainer.close()
+    table.close()
+  return rounds
@@ -10,11 +10,21 @@ BUILD_DIR="${ROOT_DIR}/build/lib"
 echo "[pokerbot] Building native core library..."
 mkdir -p "${BUILD_DIR}"
 
-g++ -std=c++17 -O3 -fPIC \
+g++ -std=c++17 -O3 -fPIC -pthread \
   -I"${ROOT_DIR}/cpp" \
   "${ROOT_DIR}/cpp/pokerbot/core/c_api.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/cfr.cpp" \
   "${ROOT_DIR}/cpp/pokerbot/core/hand_evaluator.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/hand_history.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/inference_scheduler.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/ismcts.cpp" \
   "${ROOT_DIR}/cpp/pokerbot/core/limit_holdem_game.cpp" \
-  -shared -o "${BUILD_DIR}/libpokerbot_core.so"
+  "${ROOT_DIR}/cpp/pokerbot/core/opponent_range.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/regret_table.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/replay.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/shared_training.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/state_pool.cpp" \
+  "${ROOT_DIR}/cpp/pokerbot/core/thread_pool.cpp" \
+  -shared -lrt -o "${BUILD_DIR}/libpokerbot_core.so"
 
 echo "[pokerbot] Output: ${BUILD_DIR}/libpokerbot_core.so"
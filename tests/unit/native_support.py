@@ -0,0 +1,20 @@
+"""Helpers shared by tests that exercise the native core library."""
+
+import sys
+from pathlib import Path
+
+
+def native_library_available() -> bool:
+  """True when a built core library sits where load_library() looks."""
+  lib_name = {
+      "linux": "libpokerbot_core.so",
+      "darwin": "libpokerbot_core.dylib",
+      "win32": "pokerbot_core.dll",
+  }.get(sys.platform, "libpokerbot_core.so")
+  repo_root = Path(__file__).resolve().parents[2]
+  candidates = [
+      repo_root / "build" / "lib" / lib_name,
+      repo_root / "build" / lib_name,
+      repo_root / "lib" / lib_name,
+  ]
+  return any(path.exists() for path in candidates)
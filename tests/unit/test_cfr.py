@@ -0,0 +1,125 @@
+import random
+import unittest
+
+from pokerbot.core.limit_holdem import LimitHoldemState
+from pokerbot.training.cfr import CfrTrainer, CfrVariant
+
+from native_support import native_library_available
+
+
+def _decks(count, seed):
+  rng = random.Random(seed)
+  decks = []
+  for _ in range(count):
+    deck = list(range(52))
+    rng.shuffle(deck)
+    decks.append(deck)
+  return decks
+
+
+def _visited_states(decks, paths, seed):
+  """Decision states along random betting paths through the given deals."""
+  rng = random.Random(seed)
+  for i in range(paths):
+    state = LimitHoldemState(seed=0)
+    state.reset_with_deck(decks[i % len(decks)])
+    while not state.is_terminal:
+      copy = LimitHoldemState(seed=0)
+      copy.restore(state.snapshot())
+      yield copy
+      state.apply_action(rng.choice(state.legal_actions()))
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class CfrTrainerTest(unittest.TestCase):
+  def test_every_variant_produces_distributions(self):
+    state = LimitHoldemState(seed=3)
+    for variant in CfrVariant:
+      for alternating in (True, False):
+        trainer = CfrTrainer(variant=variant, alternating_updates=alternating,
+                             discount_interval=10, table_capacity=1 << 18,
+                             seed=7)
+        trainer.run(30)
+        stats = trainer.stats()
+        self.assertEqual(stats.iterations, 30)
+        self.assertGreater(stats.infosets, 0)
+        strategy = trainer.average_strategy(state)
+        self.assertEqual(set(strategy), set(state.legal_actions()))
+        self.assertAlmostEqual(sum(strategy.values()), 1.0, places=6)
+
+  def test_regret_pruning_skips_work(self):
+    common = dict(variant=CfrVariant.DISCOUNTED, discount_interval=50,
+                  prune_warmup_iterations=50, table_capacity=1 << 18, seed=11)
+    full = CfrTrainer(**common)
+    pruned = CfrTrainer(regret_pruning=True, **common)
+    full.run(200)
+    pruned.run(200)
+    self.assertGreater(pruned.stats().actions_pruned, 0)
+    self.assertLess(pruned.stats().nodes_visited, full.stats().nodes_visited)
+
+  def test_cfr_plus_floors_regrets_at_zero(self):
+    decks = _decks(4, seed=1)
+    negative = {}
+    for variant in (CfrVariant.CFR_PLUS, CfrVariant.VANILLA):
+      trainer = CfrTrainer(variant=variant, table_capacity=1 << 16, seed=2)
+      trainer.set_deals(decks)
+      trainer.run(40)
+      negative[variant] = sum(
+          1 for state in _visited_states(decks, 200, seed=3)
+          for regret in trainer.infoset(state)[0].values() if regret < 0.0)
+    self.assertEqual(negative[CfrVariant.CFR_PLUS], 0)
+    # The same walk does reach negative regrets without the floor.
+    self.assertGreater(negative[CfrVariant.VANILLA], 0)
+
+  def test_discount_weights_match_formulas(self):
+    decks = _decks(4, seed=4)
+    interval = 10
+    # The discount at iteration 30 uses t = 30 / interval = 3.
+    t = 3.0
+    alpha, beta, gamma = 1.5, 0.5, 2.0
+    cases = [
+        (dict(variant=CfrVariant.LINEAR),
+         t / (t + 1), t / (t + 1), t / (t + 1)),
+        (dict(variant=CfrVariant.DISCOUNTED, alpha=alpha, beta=beta,
+              gamma=gamma),
+         t**alpha / (t**alpha + 1), t**beta / (t**beta + 1),
+         (t / (t + 1))**gamma),
+    ]
+    for overrides, positive, negative, strategy in cases:
+      trainer = CfrTrainer(discount_interval=interval, table_capacity=1 << 16,
+                           seed=5, **overrides)
+      trainer.set_deals(decks)
+      trainer.run(20)
+      states = list(_visited_states(decks, 40, seed=6))
+      before = [trainer.infoset(state) for state in states]
+      trainer.apply_discounts(20, 30)
+      signs = set()
+      for state, (regrets, sums) in zip(states, before):
+        after_regrets, after_sums = trainer.infoset(state)
+        for action, regret in regrets.items():
+          factor = positive if regret > 0.0 else negative
+          self.assertAlmostEqual(after_regrets[action], regret * factor,
+                                 delta=1e-9 * max(1.0, abs(regret)))
+          self.assertAlmostEqual(after_sums[action], sums[action] * strategy,
+                                 delta=1e-9 * max(1.0, sums[action]))
+          if regret != 0.0:
+            signs.add(regret > 0.0)
+      self.assertEqual(signs, {True, False})
+
+  def test_exploitability_falls_on_fixed_deals(self):
+    decks = _decks(4, seed=7)
+    trainer = CfrTrainer(discount_interval=10, table_capacity=1 << 16, seed=8)
+    trainer.set_deals(decks)
+    initial = trainer.exploitability(decks)
+    self.assertGreater(initial, 0.0)
+    trainer.run(20)
+    early = trainer.exploitability(decks)
+    trainer.run(100)
+    late = trainer.exploitability(decks)
+    self.assertLess(late, early)
+    self.assertLess(late, 0.25 * initial)
+    self.assertGreaterEqual(late, 0.0)
+
+
+if __name__ == "__main__":
+  unittest.main()
@@ -0,0 +1,55 @@
+import random
+import unittest
+
+from pokerbot.core.evaluator import evaluate_best_hand, evaluate_with_board
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+
+from native_support import native_library_available
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class HandEvaluatorTest(unittest.TestCase):
+  def test_board_evaluator_matches_exhaustive_search(self):
+    rng = random.Random(2024)
+    for total in (5, 6, 7):
+      for _ in range(3000):
+        cards = rng.sample(range(52), total)
+        expected = evaluate_best_hand(cards)
+        self.assertEqual(evaluate_with_board(cards[:2], cards[2:]), expected,
+                         msg=f"cards {cards}")
+
+  def test_board_evaluator_matches_on_made_hands(self):
+    # Random samples rarely reach quads or straight flushes; force them.
+    cases = [
+        [12, 25, 38, 51, 0, 13, 26],   # Quad aces with trip deuces.
+        [8, 9, 10, 11, 12, 0, 1],      # Royal flush plus low clubs.
+        [12, 0, 1, 2, 3, 16, 30],      # Wheel straight flush.
+        [0, 13, 26, 1, 14, 27, 5],     # Two sets: deuces full of threes.
+        [0, 13, 1, 14, 2, 15, 7],      # Three pairs.
+        [0, 2, 4, 6, 8, 10, 12],       # Seven-card club flush.
+    ]
+    for cards in cases:
+      for total in (5, 6, 7):
+        subset = cards[:total]
+        self.assertEqual(evaluate_with_board(subset[:2], subset[2:]),
+                         evaluate_best_hand(subset), msg=f"cards {subset}")
+
+  def test_game_state_strength_tracks_each_street(self):
+    rng = random.Random(7)
+    for _ in range(200):
+      deck = list(range(52))
+      rng.shuffle(deck)
+      state = LimitHoldemState(seed=0)
+      state.reset_with_deck(deck)
+      state.apply_action(ActionType.CALL)
+      while not state.is_terminal:
+        board = state.board_cards()
+        for player in (0, 1):
+          self.assertEqual(state.hand_strength(player),
+                           evaluate_best_hand(state.hole_cards(player) +
+                                              board))
+        state.apply_action(ActionType.CHECK)
+
+
+if __name__ == "__main__":
+  unittest.main()
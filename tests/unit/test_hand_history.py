@@ -0,0 +1,198 @@
+import tempfile
+import threading
+import unittest
+from pathlib import Path
+
+from pokerbot.core.hand_history import (
+    HandHistoryReader,
+    HandHistoryWriter,
+    ReplayStatus,
+    replay_history,
+)
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+
+from native_support import native_library_available
+
+
+def _play_hand(state: LimitHoldemState, seed: int) -> None:
+  state.reset(seed=seed)
+  while not state.is_terminal:
+    actions = state.legal_actions()
+    if ActionType.CALL in actions and seed % 3 == 0:
+      state.apply_action(ActionType.CALL)
+    elif ActionType.RAISE in actions and seed % 3 == 1:
+      state.apply_action(ActionType.RAISE)
+    else:
+      state.apply_action(actions[-1] if seed % 2 else actions[0])
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class HandHistoryTest(unittest.TestCase):
+  def test_round_trip_across_blocks(self):
+    state = LimitHoldemState(seed=0)
+    expected = []
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path, block_bytes=64) as writer:
+        for seed in range(50):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=1000 + seed)
+          expected.append(
+              (state.hole_cards(0), state.payoffs(), 1000 + seed))
+
+      with HandHistoryReader(path) as reader:
+        self.assertEqual(len(reader), 50)
+        for record, (hole0, payoffs, hand_id) in zip(reader, expected):
+          self.assertEqual(record.hand_id, hand_id)
+          self.assertEqual([record.deck[0], record.deck[2]], hole0)
+          self.assertEqual(record.payoffs, payoffs)
+          self.assertEqual(sorted(record.deck), list(range(52)))
+        self.assertEqual(reader.read(17).hand_id, 1017)
+
+  def test_out_of_range_read_raises(self):
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "empty.pbhh"
+      HandHistoryWriter(path).close()
+      with HandHistoryReader(path) as reader:
+        self.assertEqual(len(reader), 0)
+        with self.assertRaises(IndexError):
+          reader.read(0)
+
+  def test_multi_block_scans_match_random_access(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path, block_bytes=256) as writer:
+        for seed in range(300):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=seed)
+
+      with HandHistoryReader(path) as reader:
+        records = list(reader)
+        self.assertEqual([r.hand_id for r in records], list(range(300)))
+        for index in (0, 1, 57, 158, 299):
+          self.assertEqual(records[index], reader.read(index))
+
+        visited = []
+        count = reader.for_each(lambda r: visited.append(r.hand_id),
+                                predicate=lambda r: r.hand_id % 7 == 0)
+        self.assertEqual(visited, list(range(0, 300, 7)))
+        self.assertEqual(count, len(visited))
+
+        # A visitor returning False stops the scan.
+        stopped = []
+        count = reader.for_each(
+            lambda r: stopped.append(r.hand_id) or len(stopped) < 5)
+        self.assertEqual(count, 5)
+        self.assertEqual(stopped, [0, 1, 2, 3, 4])
+
+  def test_corrupted_block_fails_checksum(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path) as writer:
+        for seed in range(5):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=seed)
+      data = bytearray(path.read_bytes())
+      # File header (32 bytes), block header (16 bytes), then the payload.
+      data[32 + 16 + 3] ^= 0xFF
+      path.write_bytes(bytes(data))
+
+      with HandHistoryReader(path) as reader:
+        self.assertEqual(len(reader), 5)
+        with self.assertRaises(RuntimeError):
+          list(reader)
+        with self.assertRaises(RuntimeError):
+          reader.for_each(lambda r: True)
+        with self.assertRaises(IndexError):
+          reader.read(0)
+
+  def test_truncated_trailing_block_is_ignored(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path) as writer:
+        for seed in range(4):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=seed)
+          # One block per hand.
+          writer.flush()
+      data = path.read_bytes()
+      path.write_bytes(data[:-3])
+
+      with HandHistoryReader(path) as reader:
+        self.assertEqual(len(reader), 3)
+        self.assertEqual([r.hand_id for r in reader], [0, 1, 2])
+
+  def test_replay_verifies_logged_hands(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path, block_bytes=128) as writer:
+        for seed in range(40):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=seed)
+        # A hand that never finished is reported as incomplete.
+        state.reset(seed=99)
+        state.apply_action(ActionType.CALL)
+        writer.append(state, hand_id=99)
+
+      summary = replay_history(path, num_threads=4)
+      self.assertEqual(summary.hands, 41)
+      self.assertEqual(summary.ok, 40)
+      self.assertEqual(summary.incomplete, 1)
+      self.assertEqual(summary.failed_indices, [40])
+
+  def test_replay_streams_results_and_decisions(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path, block_bytes=96) as writer:
+        for seed in range(120):
+          _play_hand(state, seed)
+          writer.append(state, hand_id=seed)
+      with HandHistoryReader(path) as reader:
+        total_actions = sum(len(record.actions) for record in reader)
+
+      ordered = []
+      summary = replay_history(path, num_threads=4, failures_only=False,
+                               max_buffered_blocks=1,
+                               on_result=lambda r: ordered.append(r.index))
+      self.assertEqual(summary.ok, 120)
+      self.assertEqual(ordered, list(range(120)))
+
+      unordered = []
+      replay_history(path, num_threads=4, ordered=False, failures_only=False,
+                     on_result=lambda r: unordered.append(r.status))
+      self.assertEqual(unordered, [ReplayStatus.OK] * 120)
+
+      lock = threading.Lock()
+      decisions = []
+
+      def on_decision(index, decision_state, action):
+        self.assertIn(action, decision_state.legal_actions())
+        with lock:
+          decisions.append(index)
+
+      replay_history(path, num_threads=4, on_decision=on_decision)
+      self.assertEqual(len(decisions), total_actions)
+      self.assertEqual(set(decisions), set(range(120)))
+
+  def test_replay_callback_exception_propagates(self):
+    state = LimitHoldemState(seed=0)
+    with tempfile.TemporaryDirectory() as tmp:
+      path = Path(tmp) / "hands.pbhh"
+      with HandHistoryWriter(path) as writer:
+        _play_hand(state, 1)
+        writer.append(state, hand_id=1)
+
+      def on_decision(index, decision_state, action):
+        raise KeyError("feature store offline")
+
+      with self.assertRaises(KeyError):
+        replay_history(path, on_decision=on_decision)
+
+
+if __name__ == "__main__":
+  unittest.main()
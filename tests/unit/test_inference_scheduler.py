@@ -0,0 +1,109 @@
+import unittest
+
+from pokerbot.core.parallel import configure_thread_pool
+from pokerbot.core.scheduler import observation_size, run_batched_self_play
+
+from native_support import native_library_available
+
+
+def _pot_aware_policy(batch):
+  """Deterministic in the observation: call more as the pot grows."""
+  width = observation_size()
+  rows = []
+  for i in range(batch.size):
+    pot = batch.observations[i * width + width - 3]
+    rows.append([0.2, 1.0, 1.0 + pot, 0.5, 0.5])
+  return rows
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class InferenceSchedulerTest(unittest.TestCase):
+  def tearDown(self):
+    configure_thread_pool()
+
+  def _play(self, **kwargs):
+    results = {}
+
+    def on_hand(index, payoffs, snapshot):
+      self.assertNotIn(index, results)
+      results[index] = (payoffs, snapshot)
+
+    stats = run_batched_self_play(_pot_aware_policy, on_hand=on_hand,
+                                  **kwargs)
+    return stats, results
+
+  def test_plays_every_hand_in_bounded_batches(self):
+    sizes = []
+
+    def policy(batch):
+      sizes.append(batch.size)
+      for i in range(batch.size):
+        self.assertNotEqual(batch.legal_masks[i], 0)
+        self.assertFalse(batch.state(i).is_terminal)
+      return [[1.0] * 5 for _ in range(batch.size)]
+
+    stats = run_batched_self_play(policy, 40, concurrent_hands=16,
+                                  max_batch_size=8, seed=3)
+    self.assertEqual(stats.hands, 40)
+    self.assertEqual(stats.batches, len(sizes))
+    self.assertEqual(stats.decisions, sum(sizes))
+    self.assertLessEqual(stats.largest_batch, 8)
+    self.assertEqual(sum(stats.payoff_sums), 0)
+
+  def test_results_independent_of_batching_and_threads(self):
+    configure_thread_pool(1)
+    stats_a, hands_a = self._play(num_hands=30, concurrent_hands=4,
+                                  max_batch_size=2, seed=11)
+    configure_thread_pool(4)
+    stats_b, hands_b = self._play(num_hands=30, concurrent_hands=32,
+                                  max_batch_size=32, seed=11)
+    self.assertEqual(sorted(hands_a), list(range(30)))
+    self.assertEqual(hands_a, hands_b)
+    self.assertEqual(stats_a.payoff_sums, stats_b.payoff_sums)
+    self.assertEqual(stats_a.decisions, stats_b.decisions)
+
+  def test_policy_exception_propagates(self):
+    def policy(batch):
+      raise KeyError("model unavailable")
+
+    with self.assertRaises(KeyError):
+      run_batched_self_play(policy, 10, concurrent_hands=4)
+
+  def test_policy_exception_drains_in_flight_resumes(self):
+    configure_thread_pool(4)
+    calls = []
+
+    def policy(batch):
+      calls.append(batch.size)
+      if len(calls) == 3:
+        raise KeyError("model unavailable")
+      return [[1.0] * 5 for _ in range(batch.size)]
+
+    with self.assertRaises(KeyError):
+      run_batched_self_play(policy, 1000, concurrent_hands=256,
+                            max_batch_size=16)
+    self.assertEqual(len(calls), 3)
+
+  def test_batch_states_are_fetched_on_demand(self):
+    kept = []
+
+    def policy(batch):
+      kept.append(batch)
+      state = batch.state(batch.size - 1)
+      mask = sum(1 << int(action) for action in state.legal_actions())
+      self.assertEqual(mask, batch.legal_masks[batch.size - 1])
+      with self.assertRaises(IndexError):
+        batch.state(batch.size)
+      return [[1.0] * 5 for _ in range(batch.size)]
+
+    run_batched_self_play(policy, 5, concurrent_hands=4, max_batch_size=4)
+    with self.assertRaises(RuntimeError):
+      kept[0].state(0)
+
+  def test_rejects_invalid_options(self):
+    with self.assertRaises(ValueError):
+      run_batched_self_play(_pot_aware_policy, 10, max_batch_size=0)
+
+
+if __name__ == "__main__":
+  unittest.main()
@@ -64,6 +64,54 @@ class LimitHoldemStateTest(unittest.TestCase):
     self.assertEqual(state.winner, 0)
     self.assertEqual(state.payoffs(), [2, -2])
 
+  def test_hand_strength_tracks_streets(self):
+    state = LimitHoldemState(seed=1)
+    hero = [12, 25]     # Ac, Ad
+    villain = [11, 24]  # Kc, Kd
+    board = [37, 16, 33, 48, 19]  # Kh 5d 9h Js 8d
+    chosen = hero[:1] + villain[:1] + hero[1:] + villain[1:] + board
+    remaining = [card for card in range(52) if card not in chosen]
+    state.reset_with_deck(chosen + remaining)
+
+    self.assertGreater(state.hand_strength(0), state.hand_strength(1))
+    state.play_sequence([ActionType.CALL])
+    # Villain flops a set.
+    self.assertGreater(state.hand_strength(1), state.hand_strength(0))
+    state.play_sequence([ActionType.CHECK] * 6)
+    self.assertTrue(state.is_terminal)
+    self.assertEqual(state.winner, 1)
+
+  def test_snapshot_restore_resumes_hand(self):
+    state = LimitHoldemState(seed=7)
+    state.play_sequence([ActionType.RAISE, ActionType.CALL, ActionType.BET])
+    blob = state.snapshot()
+    self.assertEqual(len(blob), 64)
+
+    clone = LimitHoldemState(seed=8)
+    clone.restore(blob)
+    self.assertEqual(clone.betting_round, state.betting_round)
+    self.assertEqual(clone.current_player, state.current_player)
+    self.assertEqual(clone.pot, state.pot)
+    self.assertEqual(clone.board_cards(), state.board_cards())
+    self.assertEqual(clone.hole_cards(1), state.hole_cards(1))
+    self.assertEqual(clone.legal_actions(), state.legal_actions())
+
+    for game in (state, clone):
+      game.play_sequence([ActionType.CALL] + [ActionType.CHECK] * 4)
+    self.assertTrue(clone.is_terminal)
+    self.assertEqual(clone.payoffs(), state.payoffs())
+    self.assertEqual(clone.snapshot(), state.snapshot())
+
+  def test_reset_with_deck_rejects_invalid_decks(self):
+    state = LimitHoldemState(seed=3)
+    before = state.snapshot()
+    for deck in ([0] * 52, list(range(51)) + [52]):
+      with self.assertRaises(ValueError):
+        state.reset_with_deck(deck)
+      self.assertEqual(state.snapshot(), before)
+    state.play_sequence([ActionType.CALL, ActionType.CHECK])
+    self.assertEqual(state.betting_round, 1)
+
 
 if __name__ == "__main__":
   unittest.main()
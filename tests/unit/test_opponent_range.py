@@ -0,0 +1,104 @@
+import unittest
+
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+from pokerbot.core.range import (NUM_COMBOS, OpponentRange, combo_cards,
+                                 combo_index)
+from pokerbot.training.cfr import CfrTrainer
+
+from native_support import native_library_available
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class OpponentRangeTest(unittest.TestCase):
+  def test_combo_indexing_round_trips(self):
+    seen = set()
+    for hi in range(52):
+      for lo in range(hi):
+        index = combo_index(hi, lo)
+        self.assertEqual(index, combo_index(lo, hi))
+        self.assertEqual(combo_cards(index), (lo, hi))
+        seen.add(index)
+    self.assertEqual(seen, set(range(NUM_COMBOS)))
+
+  def test_removed_cards_zero_blocked_holdings(self):
+    opponent = OpponentRange()
+    opponent.remove_cards([0, 13])
+    self.assertEqual(opponent.total, NUM_COMBOS - 51 - 50)
+    weights = opponent.weights()
+    self.assertEqual(weights[combo_index(0, 5)], 0.0)
+    self.assertEqual(weights[combo_index(13, 40)], 0.0)
+    self.assertGreater(weights[combo_index(1, 2)], 0.0)
+    self.assertAlmostEqual(sum(weights), 1.0, places=4)
+
+  def test_update_is_bayesian_and_rejects_impossible_evidence(self):
+    opponent = OpponentRange()
+    likelihood = [0.0] * NUM_COMBOS
+    likelihood[combo_index(0, 1)] = 0.9
+    likelihood[combo_index(2, 3)] = 0.3
+    self.assertTrue(opponent.update(likelihood))
+    weights = opponent.weights()
+    self.assertAlmostEqual(weights[combo_index(0, 1)], 0.75, places=5)
+    self.assertAlmostEqual(weights[combo_index(2, 3)], 0.25, places=5)
+
+    opponent.remove_cards([0])
+    self.assertFalse(opponent.update([1.0 if i == combo_index(0, 1) else 0.0
+                                      for i in range(NUM_COMBOS)]))
+    self.assertAlmostEqual(opponent.weights()[combo_index(2, 3)], 1.0, places=5)
+
+  def test_observe_tracks_hand_with_cfr_policy(self):
+    trainer = CfrTrainer(discount_interval=10, table_capacity=1 << 18, seed=4)
+    trainer.run(20)
+    state = LimitHoldemState(seed=9)
+    state.play_sequence([ActionType.RAISE, ActionType.CALL])
+    opponent = OpponentRange()
+    self.assertTrue(opponent.observe(trainer, state, observer=1))
+    state.play_sequence([ActionType.CHECK])
+    self.assertTrue(opponent.observe(trainer, state, observer=1))
+
+    weights = opponent.weights()
+    self.assertAlmostEqual(sum(weights), 1.0, places=4)
+    for card in state.hole_cards(1) + state.board_cards():
+      for other in range(52):
+        if other != card:
+          self.assertEqual(weights[combo_index(card, other)], 0.0)
+
+    likelihood = trainer.action_likelihoods(state, ActionType.BET)
+    self.assertEqual(len(likelihood), NUM_COMBOS)
+    self.assertTrue(all(0.0 <= p <= 1.0 for p in likelihood))
+
+    with self.assertRaises(ValueError):
+      opponent.observe(trainer, LimitHoldemState(seed=9), observer=1)
+
+  def test_incremental_observe_matches_single_observe(self):
+    trainer = CfrTrainer(discount_interval=10, table_capacity=1 << 18, seed=5)
+    trainer.run(20)
+    actions = [ActionType.RAISE, ActionType.CALL, ActionType.BET,
+               ActionType.RAISE, ActionType.CALL, ActionType.CHECK]
+    stepwise = OpponentRange()
+    state = LimitHoldemState(seed=12)
+    for action in actions:
+      state.play_sequence([action])
+      stepwise.observe(trainer, state, observer=0)
+    whole = OpponentRange()
+    whole.observe(trainer, state, observer=0)
+    for a, b in zip(stepwise.weights(), whole.weights()):
+      self.assertAlmostEqual(a, b, places=6)
+
+    # Observing again with no new actions leaves the range as it was.
+    observed = stepwise.weights(normalized=False)
+    self.assertTrue(stepwise.observe(trainer, state, observer=0))
+    self.assertEqual(stepwise.weights(normalized=False), observed)
+
+    # The cursor belongs to one hand until reset, and a rejected state
+    # leaves the range untouched.
+    other = LimitHoldemState(seed=13)
+    other.play_sequence(actions + [ActionType.CHECK])
+    with self.assertRaises(ValueError):
+      stepwise.observe(trainer, other, observer=0)
+    self.assertEqual(stepwise.weights(normalized=False), observed)
+    stepwise.reset()
+    self.assertTrue(stepwise.observe(trainer, other, observer=0))
+
+
+if __name__ == "__main__":
+  unittest.main()
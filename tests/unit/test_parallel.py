@@ -0,0 +1,91 @@
+import threading
+import time
+import unittest
+
+from pokerbot.core.limit_holdem import LimitHoldemState
+from pokerbot.core.parallel import (NumaPolicy, configure_thread_pool,
+                                    parallel_for, parallel_sum, task_seed,
+                                    thread_pool_size)
+from pokerbot.core.search import ismcts_search
+
+from native_support import native_library_available
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class ThreadPoolTest(unittest.TestCase):
+  def tearDown(self):
+    configure_thread_pool()
+
+  def test_configure_sets_pool_size(self):
+    configure_thread_pool(3, pin_threads=True, numa_policy=NumaPolicy.SPREAD)
+    self.assertEqual(thread_pool_size(), 3)
+    state = LimitHoldemState(seed=5)
+    result = ismcts_search(state, max_iterations=500, seed=2)
+    self.assertEqual(sum(result.visits.values()), 500)
+
+  def test_rejects_invalid_configuration(self):
+    with self.assertRaises(ValueError):
+      configure_thread_pool(-1)
+    with self.assertRaises(ValueError):
+      configure_thread_pool(2, numa_policy=7)
+
+  def test_task_seed_is_deterministic(self):
+    self.assertEqual(task_seed(42, 3), task_seed(42, 3))
+    self.assertNotEqual(task_seed(42, 3), task_seed(42, 4))
+    self.assertNotEqual(task_seed(42, 3), task_seed(43, 3))
+
+  def test_parallel_for_covers_range_and_propagates_errors(self):
+    configure_thread_pool(4)
+    seen = []
+    lock = threading.Lock()
+
+    def body(lo, hi):
+      with lock:
+        seen.extend(range(lo, hi))
+
+    parallel_for(3, 103, 7, body)
+    self.assertEqual(sorted(seen), list(range(3, 103)))
+
+    def failing(lo, hi):
+      if lo == 14:
+        raise KeyError(lo)
+
+    with self.assertRaises(KeyError):
+      parallel_for(0, 50, 7, failing)
+
+  def test_idle_workers_steal_nested_batches(self):
+    configure_thread_pool(4)
+    threads = {0: set(), 1: set()}
+    visits = []
+    lock = threading.Lock()
+
+    def outer(lo, hi):
+      def inner(inner_lo, inner_hi):
+        time.sleep(0.02)
+        with lock:
+          threads[lo].add(threading.get_ident())
+          visits.extend((lo, i) for i in range(inner_lo, inner_hi))
+      # A batch started on a worker queues its helpers on that worker's
+      # deque, so other threads only join it by stealing.
+      parallel_for(0, 12, 1, inner)
+
+    parallel_for(0, 2, 1, outer)
+    self.assertEqual(sorted(visits),
+                     [(o, i) for o in range(2) for i in range(12)])
+    for batch_threads in threads.values():
+      self.assertGreater(len(batch_threads), 1)
+
+  def test_parallel_sum_is_deterministic_across_thread_counts(self):
+    def chunk_value(lo, hi):
+      return sum(1.0 / (i + 1) ** 1.5 for i in range(lo, hi))
+
+    expected = 0.0
+    for lo in range(0, 1000, 7):
+      expected += chunk_value(lo, min(1000, lo + 7))
+    for threads in (1, 2, 3, 8):
+      configure_thread_pool(threads)
+      self.assertEqual(parallel_sum(0, 1000, 7, chunk_value), expected)
+
+
+if __name__ == "__main__":
+  unittest.main()
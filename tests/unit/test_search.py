@@ -0,0 +1,31 @@
+import unittest
+
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+from pokerbot.core.search import ismcts_search
+
+from native_support import native_library_available
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class IsmctsSearchTest(unittest.TestCase):
+  def test_returns_legal_action_within_budget(self):
+    state = LimitHoldemState(seed=5)
+    result = ismcts_search(state, max_iterations=2000, num_threads=4, seed=1)
+    self.assertIn(result.action, state.legal_actions())
+    self.assertEqual(sum(result.visits.values()), 2000)
+
+  def test_does_not_fold_trips_facing_a_bet(self):
+    state = LimitHoldemState(seed=1)
+    hero = [12, 25]     # Ac, Ad
+    villain = [0, 14]   # 2c, 3d
+    board = [38, 51, 11, 29, 4]  # Ah As Kc 5h 6c
+    chosen = hero[:1] + villain[:1] + hero[1:] + villain[1:] + board
+    deck = chosen + [card for card in range(52) if card not in chosen]
+    state.reset_with_deck(deck)
+    state.play_sequence([ActionType.CALL, ActionType.BET])
+    result = ismcts_search(state, max_iterations=3000, num_threads=2, seed=3)
+    self.assertNotEqual(result.action, ActionType.FOLD)
+
+
+if __name__ == "__main__":
+  unittest.main()
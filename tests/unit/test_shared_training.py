@@ -0,0 +1,108 @@
+import multiprocessing
+import os
+import sys
+import tempfile
+import threading
+import time
+import unittest
+
+from pokerbot.core.limit_holdem import LimitHoldemState
+from pokerbot.training.cfr import CfrVariant
+from pokerbot.training.shared import (SharedCfrTrainer, SharedRegretTable,
+                                      run_shared_worker)
+
+from native_support import native_library_available
+
+
+_CAPACITY = 1 << 18
+_WORKERS = 2
+_ITERATIONS_PER_ROUND = 5
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+@unittest.skipUnless(sys.platform.startswith("linux"), "POSIX shm test")
+class SharedTrainingTest(unittest.TestCase):
+  def setUp(self):
+    self.name = f"pokerbot-test-{os.getpid()}-{time.monotonic_ns()}"
+
+  def test_workers_share_one_table(self):
+    table = SharedRegretTable.create(self.name, _WORKERS, _CAPACITY)
+    options = dict(variant=CfrVariant.DISCOUNTED, discount_interval=10,
+                   table_capacity=_CAPACITY, timeout_ms=60000)
+    context = multiprocessing.get_context("spawn")
+    with tempfile.TemporaryDirectory() as directory, \
+        context.Pool(_WORKERS) as pool:
+      results = [
+          pool.apply_async(run_shared_worker,
+                           (self.name, index, _ITERATIONS_PER_ROUND, 3),
+                           options)
+          for index in range(_WORKERS)
+      ]
+      deadline = time.monotonic() + 60
+      while table.iteration < 4 * _WORKERS * _ITERATIONS_PER_ROUND:
+        self.assertLess(time.monotonic(), deadline)
+        time.sleep(0.01)
+      checkpoint = os.path.join(directory, "cfr.ckpt")
+      self.assertTrue(table.checkpoint(checkpoint, timeout_ms=60000))
+      table.request_stop()
+      rounds = [result.get(timeout=60) for result in results]
+
+      # Every worker leaves at the same barrier; the stopping round counts.
+      self.assertEqual(rounds[0], rounds[1])
+      self.assertEqual(table.iteration,
+                       (rounds[0] + 1) * _WORKERS * _ITERATIONS_PER_ROUND)
+
+      restored = SharedRegretTable.create(self.name + "-restored", 1,
+                                          _CAPACITY)
+      restored.load_checkpoint(checkpoint)
+      self.assertGreater(restored.iteration, 0)
+      trainer = SharedCfrTrainer(restored, table_capacity=_CAPACITY)
+      state = LimitHoldemState(seed=3)
+      strategy = trainer.average_strategy(state)
+      self.assertAlmostEqual(sum(strategy.values()), 1.0, places=6)
+      trainer.close()
+      restored.close()
+    table.close()
+
+  def test_concurrent_checkpoint_requests_claim_one_slot(self):
+    table = SharedRegretTable.create(self.name, 1, _CAPACITY)
+    trainer = SharedCfrTrainer(table, table_capacity=_CAPACITY)
+    requesters = 8
+    start = threading.Barrier(requesters)
+    tickets = {}
+
+    def request(path):
+      start.wait()
+      try:
+        tickets[path] = table.request_checkpoint(path)
+      except RuntimeError:
+        pass
+
+    with tempfile.TemporaryDirectory() as directory:
+      paths = [os.path.join(directory, f"cfr-{i}.ckpt")
+               for i in range(requesters)]
+      threads = [threading.Thread(target=request, args=(path,))
+                 for path in paths]
+      for thread in threads:
+        thread.start()
+      for thread in threads:
+        thread.join()
+      self.assertEqual(len(tickets), 1)
+      (winner, ticket), = tickets.items()
+
+      self.assertTrue(trainer.run_round(1, timeout_ms=60000))
+      self.assertTrue(table.wait_checkpoint(ticket, timeout_ms=60000))
+      self.assertEqual(sorted(os.listdir(directory)),
+                       [os.path.basename(winner)])
+      # The slot is free again once the checkpoint completes.
+      self.assertNotEqual(table.request_checkpoint(paths[0]), ticket)
+    trainer.close()
+    table.close()
+
+  def test_attach_requires_existing_segment(self):
+    with self.assertRaises(RuntimeError):
+      SharedRegretTable.attach(self.name)
+
+
+if __name__ == "__main__":
+  unittest.main()
@@ -0,0 +1,60 @@
+import unittest
+
+from pokerbot.core.limit_holdem import ActionType, LimitHoldemState
+from pokerbot.core.native import Status
+from pokerbot.core.pool import PoolError, StatePool
+
+from native_support import native_library_available
+
+
+@unittest.skipUnless(native_library_available(), "Native library not built")
+class StatePoolTest(unittest.TestCase):
+  def test_batched_play_matches_single_state(self):
+    pool = StatePool(8)
+    handles = pool.acquire(4)
+    self.assertEqual(pool.in_use, 4)
+    pool.reset(handles, [10, 11, 12, 13])
+    statuses = pool.apply(handles, [ActionType.CALL] * 4)
+    self.assertEqual(statuses, [Status.OK] * 4)
+
+    reference = LimitHoldemState(seed=12)
+    reference.apply_action(ActionType.CALL)
+    info = pool.query(handles)[2]
+    self.assertEqual(info.betting_round, reference.betting_round)
+    self.assertEqual(info.current_player, reference.current_player)
+    self.assertEqual(info.pot, reference.pot)
+    self.assertEqual(info.legal_action_mask,
+                     (1 << ActionType.CHECK) | (1 << ActionType.BET))
+
+  def test_illegal_actions_and_stale_handles_report_status(self):
+    pool = StatePool(2)
+    handles = pool.acquire(2)
+    pool.reset(handles, [1, 2])
+    statuses = pool.apply(handles, [ActionType.CHECK, ActionType.CALL])
+    self.assertEqual(statuses, [Status.ILLEGAL_ACTION, Status.OK])
+
+    with self.assertRaises(PoolError) as ctx:
+      pool.acquire(1)
+    self.assertEqual(ctx.exception.status, Status.POOL_EXHAUSTED)
+
+    pool.release(handles[:1])
+    self.assertEqual(pool.apply(handles[:1], [ActionType.CALL]),
+                     [Status.INVALID_HANDLE])
+    fresh = pool.acquire(1)
+    self.assertNotEqual(fresh[0], handles[0])
+
+  def test_reset_with_decks_rejects_invalid_decks(self):
+    pool = StatePool(2)
+    handles = pool.acquire(2)
+    pool.reset(handles, [3, 4])
+    valid = list(range(52))
+    repeated = [0] * 52
+    with self.assertRaises(PoolError) as ctx:
+      pool.reset_with_decks(handles, [valid, repeated])
+    self.assertEqual(ctx.exception.status, Status.INVALID_ARGUMENT)
+    self.assertEqual(pool.apply(handles, [ActionType.CALL] * 2),
+                     [Status.OK] * 2)
+
+
+if __name__ == "__main__":
+  unittest.main()